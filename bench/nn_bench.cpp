@@ -0,0 +1,167 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include <benchmark/benchmark.h>
+#include <module.h>
+#include <hidden_layer.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+#ifdef NN_PROFILING
+    // Profiling builds link nn_alloc_counter, whose operator new counts per thread. Benchmarks run on the main thread.
+    std::size_t allocationCount() { return nn::Profiler::threadAllocations(); }
+#else
+    std::atomic<std::size_t> allocations{0};
+
+    std::size_t allocationCount() { return allocations.load(); }
+#endif
+
+    const nn::vi_t widths = {16, 64, 256};
+    const nn::vi_t depths = {1, 2, 4};
+
+    /**
+     * Counts the allocations made while a benchmark runs, reported per iteration.
+     */
+    class AllocationCounter {
+        benchmark::State &state;
+        std::size_t start;
+
+    public:
+        explicit AllocationCounter(benchmark::State &state) : state(state), start(allocationCount()) {}
+
+        ~AllocationCounter() {
+            state.counters["allocs"] = benchmark::Counter(static_cast<double>(allocationCount() - start),
+                                                          benchmark::Counter::kAvgIterations);
+        }
+    };
+
+    nn::vd_t values(std::size_t n) {
+        nn::vd_t v(n);
+        for (std::size_t i = 0; i < n; ++i) { v[i] = static_cast<nn::real_t>((i % 7) / 7.0 - 0.4); }
+        return v;
+    }
+
+    /**
+     * @return Dimensions of a network with `depth` hidden layers of `width` neurons, and as many inputs and outputs.
+     */
+    nn::vi_t dimensions(std::size_t width, std::size_t depth) {
+        return nn::vi_t(depth + 2, static_cast<nn::ui_t>(width));
+    }
+
+    void widthArgs(benchmark::internal::Benchmark *b) {
+        for (auto w: widths) { b->Arg(w); }
+    }
+
+    void networkArgs(benchmark::internal::Benchmark *b) {
+        b->ArgNames({"width", "depth"});
+        for (auto w: widths) { for (auto d: depths) { b->Args({w, d}); }}
+    }
+}
+
+#ifndef NN_PROFILING
+void *operator new(std::size_t size) {
+    ++allocations;
+    if (void *p = std::malloc(size ? size : 1)) { return p; }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+#endif
+
+static void NeuronProcess(benchmark::State &state) {
+    auto n = static_cast<nn::ui_t>(state.range(0));
+    nn::Neuron neuron = nn::make::neuron(n, -1, 1);
+    nn::vd_t inputs = values(n);
+    AllocationCounter counter(state);
+    for (auto _: state) { benchmark::DoNotOptimize(neuron.process(inputs)); }
+}
+BENCHMARK(NeuronProcess)->Apply(widthArgs);
+
+static void NeuronAdjust(benchmark::State &state) {
+    auto n = static_cast<nn::ui_t>(state.range(0));
+    nn::Neuron neuron = nn::make::neuron(n, -1, 1);
+    nn::vd_t inputs = values(n);
+    AllocationCounter counter(state);
+    for (auto _: state) {
+        neuron.adjust(inputs, 1e-3, 1e-3);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(NeuronAdjust)->Apply(widthArgs);
+
+static void LayerProcess(benchmark::State &state) {
+    auto n = static_cast<nn::ui_t>(state.range(0));
+    nn::HiddenLayer layer(nn::make::layer(n, n), nn::act::tanh);
+    nn::vd_t inputs = values(n), outputs;
+    layer.process(inputs, outputs);
+    AllocationCounter counter(state);
+    for (auto _: state) {
+        layer.process(inputs, outputs);
+        benchmark::DoNotOptimize(outputs.data());
+    }
+}
+BENCHMARK(LayerProcess)->Apply(widthArgs);
+
+static void HiddenLayerActivate(benchmark::State &state) {
+    auto n = static_cast<nn::ui_t>(state.range(0));
+    nn::HiddenLayer layer(nn::make::layer(n, n), nn::act::tanh);
+    nn::vd_t inputs = values(n), outputs;
+    layer.activate(inputs, outputs);
+    AllocationCounter counter(state);
+    for (auto _: state) {
+        layer.activate(inputs, outputs);
+        benchmark::DoNotOptimize(outputs.data());
+    }
+}
+BENCHMARK(HiddenLayerActivate)->Apply(widthArgs);
+
+static void LayerPropagateErrorBackward(benchmark::State &state) {
+    auto n = static_cast<nn::ui_t>(state.range(0));
+    nn::HiddenLayer layer(nn::make::layer(n, n), nn::act::tanh);
+    nn::vd_t inputs = values(n), errors;
+    layer.activateAndCache(inputs);
+    layer.calculateGradientsAndCash(values(n));
+    layer.propagateErrorBackward(errors);
+    AllocationCounter counter(state);
+    for (auto _: state) {
+        layer.propagateErrorBackward(errors);
+        benchmark::DoNotOptimize(errors.data());
+    }
+}
+BENCHMARK(LayerPropagateErrorBackward)->Apply(widthArgs);
+
+static void NetworkTrain(benchmark::State &state) {
+    auto width = static_cast<std::size_t>(state.range(0)), depth = static_cast<std::size_t>(state.range(1));
+    nn::Network network = nn::make::network(dimensions(width, depth), nn::act::tanh, nn::loss::sse);
+    nn::vd_t input = values(width), output(width, 0);
+    output[0] = 1;
+    network.train(input, output, 1e-3);
+    AllocationCounter counter(state);
+    for (auto _: state) { benchmark::DoNotOptimize(network.train(input, output, 1e-3)); }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(NetworkTrain)->Apply(networkArgs);
+
+static void ModulePredict(benchmark::State &state) {
+    constexpr std::size_t rows = 256;
+    auto width = static_cast<std::size_t>(state.range(0)), depth = static_cast<std::size_t>(state.range(1));
+    nn::Module module(nn::make::network(dimensions(width, depth), nn::act::tanh, nn::loss::sse));
+    nn::vd_t inputs = values(rows * width), outputs(rows * width);
+    module.setTrainInput(inputs.data(), rows, width);
+    module.setTrainOutput(inputs.data(), rows, width);
+    AllocationCounter counter(state);
+    for (auto _: state) {
+        module.predict(inputs.data(), rows, outputs.data());
+        benchmark::DoNotOptimize(outputs.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * rows));
+}
+BENCHMARK(ModulePredict)->Apply(networkArgs);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,620 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include <module.h>
+#include <model_file.h>
+#include <csv_codec.h>
+#include <cross_validation.h>
+#include <sweep.h>
+#include <thread_pool.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    const char *usage = R"(Usage:
+  nn_cli train [options]
+    --data <dir>             Directory with train_in.csv and train_out.csv, and optionally
+                             test_in.csv and test_out.csv. Default is the current directory.
+    --dimensions <a,b,...,z> Network dimensions, the number of inputs first, at least one hidden
+                             layer. Required.
+    --activation <name>      Hidden layers activation: tanh, sigmoid, relu or linear. Default is tanh.
+    --loss <name>            Loss function: sse, mse or crossEntropy. Default is sse.
+    --learning-rate <value>  Default is 0.01.
+    --optimizer <name>       Update rule: sgd, momentum, nesterov, rmsprop or adam. Default is sgd.
+    --epochs <count>         Default is 100.
+    --batch-size <count>     Default is 1.
+    --threads <count>        Training threads, 0 for one per hardware thread. Default is 1.
+    --sampling <name>        Order of the rows in every epoch: sequential, shuffle, stratified
+                             or bootstrap. Default is sequential.
+    --init <name>            Initial weights: auto, xavier, he or range. Auto is He for relu
+                             and Xavier otherwise. Default is auto.
+    --seed <value>           Seed of the initial weights and the sampling orders. Default is 0.
+    --encoding <name>        Categorical columns encoding: label or oneHot. Default is label.
+    --report <count>         Prints the errors every <count> epochs. Default is 10.
+    --model <file>           Where the binary model is written. Default is model.nnm.
+
+  nn_cli score [options] <file.csv>...
+    --model <file>           Binary model written by train. Required.
+    --threads <count>        Scoring threads, 0 for one per hardware thread. Default is 0.
+    --fit <file.csv>         Training input file, to encode categorical columns like in training.
+    --fit-output <file.csv>  Training output file, to decode the predictions like the training outputs,
+                             writing category names for categorical columns.
+    --encoding <name>        Categorical columns encoding used in training. Default is label.
+    --out <dir>              Where the predictions are written. Default is next to each file.
+                             Predictions of <name>.csv are written to <name>_pred.csv.
+
+  nn_cli validate [options]
+    Takes the options of train, except --model, and cross-validates on the training files.
+    --folds <count>          Number of folds. Default is 5.
+    --threads <count>        Folds trained at once, 0 for one per hardware thread. Default is 0.
+
+  nn_cli sweep [options]
+    Takes the options of train, except --report, --model and --init, with comma separated candidates
+    for --activation, --loss, --learning-rate and --epochs, and ';' separated candidates for --dimensions.
+    --search <name>          grid trains every combination, random draws --trials of them,
+                             with learning rates on a log scale between the candidates. Default is grid.
+    --trials <count>         Number of random configurations. Default is 20.
+    --threads <count>        Configurations trained at once, 0 for one per hardware thread. Default is 0.
+    --top <count>            Number of configurations printed, best first. Default is 10.
+)";
+
+    /**
+     * Number of rows each worker scores at once.
+     */
+    constexpr std::size_t scoringChunk = 256;
+
+    struct Options {
+        std::string command;
+        std::map<std::string, std::string> flags;
+        std::vector<std::string> files;
+
+        [[nodiscard]] std::string get(const std::string &flag, const std::string &fallback) const {
+            auto it = flags.find(flag);
+            return it == flags.end() ? fallback : it->second;
+        }
+    };
+
+    /**
+     * Splits the arguments into the command, `--flag value` pairs and positional files.
+     * @return The options, or nothing if a flag is missing its value.
+     */
+    std::optional<Options> parseArguments(int argc, char **argv) {
+        if (argc < 2) { return std::nullopt; }
+        Options options;
+        options.command = argv[1];
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg.rfind("--", 0) != 0) {
+                options.files.push_back(arg);
+            } else if (i + 1 < argc) {
+                options.flags[arg.substr(2)] = argv[++i];
+            } else {
+                std::cerr << "Missing value of " << arg << "\n";
+                return std::nullopt;
+            }
+        }
+        return options;
+    }
+
+    /**
+     * @return Whether every flag of the options is one of the allowed flags.
+     */
+    bool checkFlags(const Options &options, const std::vector<std::string> &allowed) {
+        for (const auto &[flag, value]: options.flags) {
+            if (std::find(allowed.begin(), allowed.end(), flag) == allowed.end()) {
+                std::cerr << "Unknown option --" << flag << "\n";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template<typename T>
+    std::optional<T> parseNumber(const std::string &text) {
+        // Streams read "-1" into an unsigned value as its wrapped around maximum
+        if (std::is_unsigned_v<T> && text.find('-') != std::string::npos) { return std::nullopt; }
+        std::istringstream in(text);
+        T value;
+        if (!(in >> value) || !in.eof()) { return std::nullopt; }
+        return value;
+    }
+
+    std::optional<nn::vi_t> parseDimensions(const std::string &text) {
+        nn::vi_t dimensions;
+        std::istringstream in(text);
+        for (std::string item; std::getline(in, item, ',');) {
+            auto value = parseNumber<unsigned long>(item);
+            if (!value || *value == 0 || *value > std::numeric_limits<nn::ui_t>::max()) { return std::nullopt; }
+            dimensions.push_back(static_cast<nn::ui_t>(*value));
+        }
+        // Networks have at least one hidden layer
+        if (dimensions.size() < 3) { return std::nullopt; }
+        return dimensions;
+    }
+
+    std::optional<nn::act::Function> parseActivation(const std::string &name) {
+        if (name == "tanh") { return nn::act::tanh; }
+        if (name == "sigmoid") { return nn::act::sigmoid; }
+        if (name == "relu") { return nn::act::relu; }
+        if (name == "linear") { return nn::act::linear; }
+        return std::nullopt;
+    }
+
+    std::optional<nn::loss::function_t> parseLoss(const std::string &name) {
+        if (name == "sse") { return nn::loss::sse; }
+        if (name == "mse") { return nn::loss::mse; }
+        if (name == "crossEntropy") { return nn::loss::crossEntropy; }
+        return std::nullopt;
+    }
+
+    /**
+     * Parses every item of a separated list.
+     * @return The parsed items, or nothing if the list is empty or an item is invalid.
+     */
+    template<typename Parse>
+    auto parseList(const std::string &text, char separator, Parse parse)
+    -> std::optional<std::vector<typename decltype(parse(text))::value_type>> {
+        std::vector<typename decltype(parse(text))::value_type> items;
+        std::istringstream in(text);
+        for (std::string item; std::getline(in, item, separator);) {
+            auto value = parse(item);
+            if (!value) { return std::nullopt; }
+            items.push_back(*value);
+        }
+        if (items.empty()) { return std::nullopt; }
+        return items;
+    }
+
+    std::string activationName(const nn::act::Function &function) {
+        for (const char *name: {"tanh", "sigmoid", "relu", "linear"}) {
+            if (parseActivation(name)->fun == function.fun) { return name; }
+        }
+        return "custom";
+    }
+
+    std::string lossName(nn::loss::function_t function) {
+        for (const char *name: {"sse", "mse", "crossEntropy"}) {
+            if (*parseLoss(name) == function) { return name; }
+        }
+        return "custom";
+    }
+
+    std::string dimensionsName(const nn::vi_t &dimensions) {
+        std::string name;
+        for (auto d: dimensions) { name += (name.empty() ? "" : ",") + std::to_string(d); }
+        return name;
+    }
+
+    std::optional<nn::Optimizer> parseOptimizer(const std::string &name) {
+        if (name == "sgd") { return nn::Optimizer::sgd(); }
+        if (name == "momentum") { return nn::Optimizer::momentum(); }
+        if (name == "nesterov") { return nn::Optimizer::momentum(0.9, true); }
+        if (name == "rmsprop") { return nn::Optimizer::rmsprop(); }
+        if (name == "adam") { return nn::Optimizer::adam(); }
+        return std::nullopt;
+    }
+
+    std::optional<nn::Module::Sampling> parseSampling(const std::string &name) {
+        if (name == "sequential") { return nn::Module::Sampling::Sequential; }
+        if (name == "shuffle") { return nn::Module::Sampling::Shuffle; }
+        if (name == "stratified") { return nn::Module::Sampling::Stratified; }
+        if (name == "bootstrap") { return nn::Module::Sampling::Bootstrap; }
+        return std::nullopt;
+    }
+
+    std::optional<nn::make::Init> parseInit(const std::string &name) {
+        if (name == "auto") { return nn::make::Init::Auto; }
+        if (name == "xavier") { return nn::make::Init::Xavier; }
+        if (name == "he") { return nn::make::Init::He; }
+        if (name == "range") { return nn::make::Init::Range; }
+        return std::nullopt;
+    }
+
+    std::optional<nn::CsvCodec::Encoding> parseEncoding(const std::string &name) {
+        if (name == "label") { return nn::CsvCodec::Encoding::Label; }
+        if (name == "oneHot") { return nn::CsvCodec::Encoding::OneHot; }
+        return std::nullopt;
+    }
+
+    /**
+     * Reads a CSV file, fitting the codec on it or encoding it with the fitted columns.
+     * @return The encoded rows, or nothing if the file can't be read or its rows have different widths.
+     */
+    std::optional<nn::vvd_t> readCsv(const fs::path &path, nn::CsvCodec &codec, bool fit, const std::string &prefix) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            std::cerr << "Can't read " << path.string() << "\n";
+            return std::nullopt;
+        }
+        nn::vvd_t rows = fit ? codec.fit(in, prefix) : codec.encode(in);
+        for (const auto &row: rows) {
+            if (row.size() != rows.front().size()) {
+                std::cerr << "Rows of " << path.string() << " have different widths\n";
+                return std::nullopt;
+            }
+        }
+        return rows;
+    }
+
+    /**
+     * @return The rows stacked row-major.
+     */
+    nn::vd_t stack(const nn::vvd_t &rows) {
+        nn::vd_t values;
+        values.reserve(rows.empty() ? 0 : rows.size() * rows.front().size());
+        for (const auto &row: rows) { values.insert(values.end(), row.begin(), row.end()); }
+        return values;
+    }
+
+    bool writeCsv(const fs::path &path, const nn::real_t *values, std::size_t rows, std::size_t width) {
+        std::ofstream out(path, std::ios::binary);
+        if (!out) { return false; }
+        out.precision(std::numeric_limits<nn::real_t>::digits10);
+        for (std::size_t r = 0; r < rows; ++r) {
+            for (std::size_t c = 0; c < width; ++c) { out << (c ? "," : "") << values[r * width + c]; }
+            out << '\n';
+        }
+        return static_cast<bool>(out);
+    }
+
+    /**
+     * Writes the rows decoded by a codec fitted on the training output, one value per output column.
+     */
+    bool writeCsv(const fs::path &path, const nn::real_t *values, std::size_t rows, std::size_t width,
+                  const nn::CsvCodec &codec) {
+        std::ofstream out(path, std::ios::binary);
+        if (!out) { return false; }
+        for (std::size_t r = 0; r < rows; ++r) {
+            auto decoded = codec.decode(values + r * width);
+            for (std::size_t c = 0; c < decoded.size(); ++c) { out << (c ? "," : "") << decoded[c]; }
+            out << '\n';
+        }
+        return static_cast<bool>(out);
+    }
+
+    /**
+     * The encoded training data and, when the files exist, the testing data.
+     */
+    struct Data {
+        nn::vvd_t trainInput, trainOutput, testInput, testOutput;
+    };
+
+    /**
+     * Reads the CSV files of a dataset directory, see the usage of train.
+     * @return The data, or nothing if a file can't be read or the training files don't match.
+     */
+    std::optional<Data> readData(const fs::path &directory, nn::CsvCodec::Encoding encoding) {
+        nn::CsvCodec inputCodec(encoding), outputCodec(encoding);
+        auto trainInput = readCsv(directory / "train_in.csv", inputCodec, true, "Input");
+        auto trainOutput = readCsv(directory / "train_out.csv", outputCodec, true, "Output");
+        if (!trainInput || !trainOutput) { return std::nullopt; }
+        if (trainInput->empty() || trainInput->size() != trainOutput->size()) {
+            std::cerr << "Training input and output must have the same number of rows\n";
+            return std::nullopt;
+        }
+
+        Data data{std::move(*trainInput), std::move(*trainOutput), {}, {}};
+        if (fs::exists(directory / "test_in.csv") && fs::exists(directory / "test_out.csv")) {
+            auto testInput = readCsv(directory / "test_in.csv", inputCodec, false, "Input");
+            auto testOutput = readCsv(directory / "test_out.csv", outputCodec, false, "Output");
+            if (!testInput || !testOutput) { return std::nullopt; }
+            data.testInput = std::move(*testInput);
+            data.testOutput = std::move(*testOutput);
+        }
+        return data;
+    }
+
+    /**
+     * @return Whether the first and last dimensions match the widths of the data, printing an error otherwise.
+     */
+    bool checkDimensions(const nn::vi_t &dimensions, const Data &data) {
+        auto inputs = data.trainInput.front().size(), outputs = data.trainOutput.front().size();
+        if (inputs == dimensions.front() && outputs == dimensions.back()) { return true; }
+        std::cerr << "Dimensions " << dimensionsName(dimensions) << " don't match the data: " << inputs
+                  << " inputs and " << outputs << " outputs\n";
+        return false;
+    }
+
+    int train(const Options &options) {
+        if (!checkFlags(options, {"data", "dimensions", "activation", "loss", "learning-rate", "optimizer",
+                                  "epochs", "batch-size", "threads", "sampling", "init", "seed", "encoding",
+                                  "report", "model"})) { return 2; }
+        auto dimensions = parseDimensions(options.get("dimensions", ""));
+        auto activation = parseActivation(options.get("activation", "tanh"));
+        auto loss = parseLoss(options.get("loss", "sse"));
+        auto rate = parseNumber<nn::real_t>(options.get("learning-rate", "0.01"));
+        auto optimizer = parseOptimizer(options.get("optimizer", "sgd"));
+        auto epochs = parseNumber<std::size_t>(options.get("epochs", "100"));
+        auto batchSize = parseNumber<std::size_t>(options.get("batch-size", "1"));
+        auto threads = parseNumber<std::size_t>(options.get("threads", "1"));
+        auto sampling = parseSampling(options.get("sampling", "sequential"));
+        auto init = parseInit(options.get("init", "auto"));
+        auto seed = parseNumber<std::uint32_t>(options.get("seed", "0"));
+        auto encoding = parseEncoding(options.get("encoding", "label"));
+        auto report = parseNumber<std::size_t>(options.get("report", "10"));
+        if (!dimensions || !activation || !loss || !rate || !optimizer || !epochs || !batchSize || *batchSize == 0
+            || !threads || !sampling || !init || !seed || !encoding || !report || *report == 0) {
+            std::cerr << "Invalid or missing training options\n";
+            return 2;
+        }
+
+        auto data = readData(options.get("data", "."), *encoding);
+        if (!data || !checkDimensions(*dimensions, *data)) { return 1; }
+
+        nn::make::seed(*seed);
+        nn::Module module(nn::make::network(*dimensions, *activation, *loss, *init));
+        module.setLearningRate(*rate);
+        module.setOptimizer(*optimizer);
+        module.setThreads(*threads);
+        module.setSampling(*sampling);
+        module.setSeed(*seed);
+        module.setTrainInput(data->trainInput);
+        module.setTrainOutput(data->trainOutput);
+
+        bool withTest = !data->testInput.empty();
+        if (withTest) {
+            module.setTestInput(data->testInput);
+            module.setTestOutput(data->testOutput);
+        }
+
+        for (std::size_t epoch = 0; epoch < *epochs;) {
+            auto count = std::min(*report, *epochs - epoch);
+            epoch += count;
+            std::cout << "epoch " << epoch;
+            if (withTest) {
+                auto errors = module.trainAndTest(count, *batchSize);
+                std::cout << " train " << errors.back().first << " test " << errors.back().second << "\n";
+            } else {
+                auto errors = module.train(count, *batchSize);
+                std::cout << " train " << errors.back() << "\n";
+            }
+        }
+
+        std::string model = options.get("model", "model.nnm");
+        if (!module.save(model)) {
+            std::cerr << "Can't write the model to " << model << "\n";
+            return 1;
+        }
+        std::cout << "model written to " << model << "\n";
+        return 0;
+    }
+
+    int validate(const Options &options) {
+        if (!checkFlags(options, {"data", "dimensions", "activation", "loss", "learning-rate", "optimizer",
+                                  "epochs", "batch-size", "threads", "sampling", "init", "seed", "encoding",
+                                  "report", "folds"})) { return 2; }
+        auto dimensions = parseDimensions(options.get("dimensions", ""));
+        auto activation = parseActivation(options.get("activation", "tanh"));
+        auto loss = parseLoss(options.get("loss", "sse"));
+        auto rate = parseNumber<nn::real_t>(options.get("learning-rate", "0.01"));
+        auto optimizer = parseOptimizer(options.get("optimizer", "sgd"));
+        auto epochs = parseNumber<std::size_t>(options.get("epochs", "100"));
+        auto batchSize = parseNumber<std::size_t>(options.get("batch-size", "1"));
+        auto threads = parseNumber<std::size_t>(options.get("threads", "0"));
+        auto sampling = parseSampling(options.get("sampling", "sequential"));
+        auto init = parseInit(options.get("init", "auto"));
+        auto seed = parseNumber<std::uint32_t>(options.get("seed", "0"));
+        auto encoding = parseEncoding(options.get("encoding", "label"));
+        auto report = parseNumber<std::size_t>(options.get("report", "10"));
+        auto folds = parseNumber<std::size_t>(options.get("folds", "5"));
+        if (!dimensions || !activation || !loss || !rate || !optimizer || !epochs || !batchSize || *batchSize == 0
+            || !threads || !sampling || !init || !seed || !encoding || !report || *report == 0
+            || !folds || *folds < 2) {
+            std::cerr << "Invalid or missing validation options\n";
+            return 2;
+        }
+
+        auto data = readData(options.get("data", "."), *encoding);
+        if (!data || !checkDimensions(*dimensions, *data)) { return 1; }
+        if (*folds > data->trainInput.size()) {
+            std::cerr << "More folds than training rows\n";
+            return 1;
+        }
+
+        nn::make::seed(*seed);
+        nn::Module module(nn::make::network(*dimensions, *activation, *loss, *init));
+        module.setLearningRate(*rate);
+        module.setOptimizer(*optimizer);
+        module.setSampling(*sampling);
+        module.setSeed(*seed);
+        module.setTrainInput(data->trainInput);
+        module.setTrainOutput(data->trainOutput);
+
+        nn::CrossValidation validation(module, *folds);
+        validation.setThreads(*threads);
+        validation.setSeed(*seed);
+        auto result = validation.run(*epochs, *batchSize);
+        for (std::size_t epoch = *report; epoch <= *epochs; epoch += *report) {
+            std::cout << "epoch " << epoch << " train " << result.trainErrors[epoch - 1] << " test "
+                      << result.testErrors[epoch - 1] << "\n";
+        }
+        for (std::size_t f = 0; f < result.folds.size(); ++f) {
+            const auto &fold = result.folds[f];
+            if (fold.testErrors.empty()) { continue; }
+            std::cout << "fold " << f + 1 << " train " << fold.trainErrors.back() << " test "
+                      << fold.testErrors.back() << "\n";
+        }
+        return 0;
+    }
+
+    int sweep(const Options &options) {
+        if (!checkFlags(options, {"data", "dimensions", "activation", "loss", "learning-rate", "optimizer",
+                                  "epochs", "batch-size", "threads", "sampling", "seed", "encoding", "search",
+                                  "trials", "top"})) { return 2; }
+        nn::Sweep::Space space;
+        auto dimensions = parseList(options.get("dimensions", ""), ';', parseDimensions);
+        auto activations = parseList(options.get("activation", "tanh"), ',', parseActivation);
+        auto losses = parseList(options.get("loss", "sse"), ',', parseLoss);
+        auto rates = parseList(options.get("learning-rate", "0.01"), ',', parseNumber<nn::real_t>);
+        auto epochs = parseList(options.get("epochs", "100"), ',', parseNumber<std::size_t>);
+        auto optimizer = parseOptimizer(options.get("optimizer", "sgd"));
+        auto batchSize = parseNumber<std::size_t>(options.get("batch-size", "1"));
+        auto threads = parseNumber<std::size_t>(options.get("threads", "0"));
+        auto sampling = parseSampling(options.get("sampling", "sequential"));
+        auto seed = parseNumber<std::uint32_t>(options.get("seed", "0"));
+        auto encoding = parseEncoding(options.get("encoding", "label"));
+        auto search = options.get("search", "grid");
+        auto trials = parseNumber<std::size_t>(options.get("trials", "20"));
+        auto top = parseNumber<std::size_t>(options.get("top", "10"));
+        if (!dimensions || !activations || !losses || !rates || !epochs || !optimizer || !batchSize
+            || *batchSize == 0 || !threads || !sampling || !seed || !encoding || !trials || !top
+            || (search != "grid" && search != "random")) {
+            std::cerr << "Invalid or missing sweep options\n";
+            return 2;
+        }
+        if (std::any_of(rates->begin(), rates->end(), [](nn::real_t rate) { return !(rate > 0); })) {
+            std::cerr << "Learning rates must be positive\n";
+            return 2;
+        }
+
+        auto data = readData(options.get("data", "."), *encoding);
+        if (!data) { return 1; }
+        for (const auto &candidate: *dimensions) {
+            if (!checkDimensions(candidate, *data)) { return 1; }
+        }
+
+        nn::Module module;
+        module.setOptimizer(*optimizer);
+        module.setSampling(*sampling);
+        module.setSeed(*seed);
+        module.setTrainInput(data->trainInput);
+        module.setTrainOutput(data->trainOutput);
+        module.setTestInput(data->testInput);
+        module.setTestOutput(data->testOutput);
+
+        space.dimensions = *dimensions;
+        space.activations = *activations;
+        space.losses = *losses;
+        space.learningRates = *rates;
+        space.epochs = *epochs;
+        auto configurations = search == "grid" ? nn::Sweep::grid(space) : nn::Sweep::random(space, *trials, *seed);
+
+        nn::Sweep sweep(module);
+        sweep.setThreads(*threads);
+        sweep.setBatchSize(*batchSize);
+        sweep.setSeed(*seed);
+        auto workers = *threads == 0 ? nn::ThreadPool::concurrency() : *threads;
+        std::cout << "training " << configurations.size() << " configurations on " << workers << " threads\n";
+        auto start = std::chrono::steady_clock::now();
+        auto results = sweep.run(configurations);
+        auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "rank dimensions activation loss learning-rate epochs train test seconds\n";
+        for (std::size_t i = 0; i < std::min(*top, results.size()); ++i) {
+            const auto &result = results[i];
+            const auto &configuration = result.configuration;
+            std::cout << i + 1 << " " << dimensionsName(configuration.dimensions) << " "
+                      << activationName(configuration.activation) << " " << lossName(configuration.loss) << " "
+                      << configuration.learningRate << " " << configuration.epochs << " " << result.trainError
+                      << " " << result.testError << " " << result.seconds << "\n";
+        }
+        std::cout << "sweep took " << seconds << " seconds\n";
+        return 0;
+    }
+
+    int score(const Options &options) {
+        if (!checkFlags(options, {"model", "threads", "fit", "fit-output", "encoding", "out"})) { return 2; }
+        auto threads = parseNumber<std::size_t>(options.get("threads", "0"));
+        auto encoding = parseEncoding(options.get("encoding", "label"));
+        if (!options.flags.count("model") || !threads || !encoding || options.files.empty()) {
+            std::cerr << "Invalid or missing scoring options\n";
+            return 2;
+        }
+
+        auto model = nn::ModelFile::open(options.get("model", ""));
+        if (!model) {
+            std::cerr << "Can't open the model " << options.get("model", "") << "\n";
+            return 1;
+        }
+        auto inputs = model->getDimensions().front(), outputs = model->getDimensions().back();
+
+        // Without the training input every column is read as numeric
+        nn::CsvCodec codec(*encoding);
+        if (options.flags.count("fit") && !readCsv(options.get("fit", ""), codec, true, "Input")) { return 1; }
+
+        // Without the training output the raw network outputs are written
+        std::optional<nn::CsvCodec> outputCodec;
+        if (options.flags.count("fit-output")) {
+            outputCodec.emplace(*encoding);
+            if (!readCsv(options.get("fit-output", ""), *outputCodec, true, "Output")) { return 1; }
+            if (outputCodec->getHeaders(true).size() != outputs) {
+                std::cerr << options.get("fit-output", "") << " has " << outputCodec->getHeaders(true).size()
+                          << " encoded columns, the model gives " << outputs << "\n";
+                return 1;
+            }
+        }
+
+        std::error_code error;
+        if (options.flags.count("out") && !fs::create_directories(options.get("out", ""), error) && error) {
+            std::cerr << "Can't create " << options.get("out", "") << "\n";
+            return 1;
+        }
+
+        nn::ThreadPool pool(*threads);
+        int status = 0;
+        for (const auto &file: options.files) {
+            fs::path path = file;
+            auto rows = readCsv(path, codec, false, "Input");
+            if (!rows) {
+                status = 1;
+                continue;
+            }
+            if (!rows->empty() && rows->front().size() != inputs) {
+                std::cerr << path.string() << " has " << rows->front().size() << " columns, the model takes "
+                          << inputs << "\n";
+                status = 1;
+                continue;
+            }
+
+            // The mapped model is read-only, workers score their chunks of rows without sharing anything
+            nn::vd_t x = stack(*rows), y(rows->size() * outputs);
+            auto chunks = (rows->size() + scoringChunk - 1) / scoringChunk;
+            pool.run([&](std::size_t w) {
+                for (auto c = w; c < chunks; c += pool.size()) {
+                    auto from = c * scoringChunk, count = std::min(scoringChunk, rows->size() - from);
+                    model->predict(x.data() + from * inputs, count, y.data() + from * outputs);
+                }
+            });
+
+            fs::path out = options.flags.count("out") ? fs::path(options.get("out", "")) : path.parent_path();
+            out /= path.stem().string() + "_pred.csv";
+            if (!(outputCodec ? writeCsv(out, y.data(), rows->size(), outputs, *outputCodec)
+                              : writeCsv(out, y.data(), rows->size(), outputs))) {
+                std::cerr << "Can't write " << out.string() << "\n";
+                status = 1;
+                continue;
+            }
+            std::cout << path.string() << ": " << rows->size() << " rows scored to " << out.string() << "\n";
+        }
+        return status;
+    }
+}
+
+/**
+ * Native trainer and batch scorer, for training on datasets too large for a browser tab.
+ * Reads the CSV layout of the web datasets and writes the binary model format (see nn::ModelFile).
+ */
+int main(int argc, char **argv) {
+    auto options = parseArguments(argc, argv);
+    if (options && options->command == "train") { return train(*options); }
+    if (options && options->command == "score") { return score(*options); }
+    if (options && options->command == "validate") { return validate(*options); }
+    if (options && options->command == "sweep") { return sweep(*options); }
+    std::cerr << usage;
+    return 2;
+}
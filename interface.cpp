@@ -1,14 +1,20 @@
 #include "module.h"
+#include "csv_codec.h"
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <optional>
 
 #include <emscripten.h>
 #include <emscripten/bind.h>
 
-// Takes a javascript function name and calls it if it exists
+// Takes a javascript function name and calls it if it exists, on the page or in a worker
 #define CALL_JS_FUNC(FUNC_NAME) \
     EM_ASM({ \
         var funcName = UTF8ToString($0); \
-        if (typeof window[funcName] === 'function') { \
-            window[funcName](); \
+        if (typeof globalThis[funcName] === 'function') { \
+            globalThis[funcName](); \
         } \
     }, FUNC_NAME);
 
@@ -16,10 +22,43 @@
 class NetworkController {
 private:
     nn::vi_t dimensions;
-    double alpha{};
+    nn::real_t alpha{};
+    std::size_t batchSize{1};
     std::string actFunction;
     std::string lossFunction;
+    nn::make::Init initialization = nn::make::Init::Auto;
+    std::optional<std::uint32_t> initializationSeed;
     nn::Module module;
+    nn::CsvCodec inputCodec;
+    nn::CsvCodec outputCodec;
+    nn::vd_t buffer;
+    nn::vd_t predictions;
+
+    /**
+     * Number of rows of each dataset as last set, shown by the page without parsing the files again.
+     */
+    std::size_t trainInputRows = 0, trainOutputRows = 0, testInputRows = 0, testOutputRows = 0;
+
+    /**
+     * Number of epochs kept by the progress ring.
+     */
+    static constexpr std::size_t progressCapacity = 1024;
+
+    nn::vd_t progress = nn::vd_t(2 * progressCapacity);
+    std::atomic<std::size_t> progressCount{0};
+    std::atomic<bool> cancelled{false};
+
+    /**
+     * Wraps row-major values in an object holding a typed array view over them and their shape.
+     * The view isn't a copy, it's only valid until the values change or the WASM memory grows.
+     */
+    static emscripten::val matrix(const nn::real_t *data, std::size_t rows, std::size_t columns) {
+        emscripten::val res = emscripten::val::object();
+        res.set("data", emscripten::typed_memory_view(rows * columns, data));
+        res.set("rows", rows);
+        res.set("columns", columns);
+        return res;
+    }
 
     static nn::vvd_t pairToVector(const nn::vpd_t &data) {
         nn::vvd_t res;
@@ -37,9 +76,106 @@ private:
         }
     }
 
+    static nn::Module::ParallelMode stringToParallelMode(const std::string &mode) {
+        if (mode == "hogwild") {
+            return nn::Module::ParallelMode::Hogwild;
+        } else {
+            return nn::Module::ParallelMode::Synchronous;
+        }
+    }
+
+    static nn::Optimizer stringToOptimizer(const std::string &optimizer) {
+        if (optimizer == "momentum") {
+            return nn::Optimizer::momentum();
+        } else if (optimizer == "nesterov") {
+            return nn::Optimizer::momentum(0.9, true);
+        } else if (optimizer == "rmsprop") {
+            return nn::Optimizer::rmsprop();
+        } else if (optimizer == "adam") {
+            return nn::Optimizer::adam();
+        } else {
+            return nn::Optimizer::sgd();
+        }
+    }
+
+    static std::string optimizerToString(const nn::Optimizer &optimizer) {
+        switch (optimizer.getMethod()) {
+            case nn::Optimizer::Method::Momentum:
+                return "momentum";
+            case nn::Optimizer::Method::Nesterov:
+                return "nesterov";
+            case nn::Optimizer::Method::RMSProp:
+                return "rmsprop";
+            case nn::Optimizer::Method::Adam:
+                return "adam";
+            default:
+                return "sgd";
+        }
+    }
+
+    static nn::Module::Sampling stringToSampling(const std::string &sampling) {
+        if (sampling == "shuffle") {
+            return nn::Module::Sampling::Shuffle;
+        } else if (sampling == "stratified") {
+            return nn::Module::Sampling::Stratified;
+        } else if (sampling == "bootstrap") {
+            return nn::Module::Sampling::Bootstrap;
+        } else {
+            return nn::Module::Sampling::Sequential;
+        }
+    }
+
+    static std::string samplingToString(nn::Module::Sampling sampling) {
+        switch (sampling) {
+            case nn::Module::Sampling::Shuffle:
+                return "shuffle";
+            case nn::Module::Sampling::Stratified:
+                return "stratified";
+            case nn::Module::Sampling::Bootstrap:
+                return "bootstrap";
+            default:
+                return "sequential";
+        }
+    }
+
+    static nn::make::Init stringToInitialization(const std::string &init) {
+        if (init == "xavier") {
+            return nn::make::Init::Xavier;
+        } else if (init == "he") {
+            return nn::make::Init::He;
+        } else if (init == "range") {
+            return nn::make::Init::Range;
+        } else {
+            return nn::make::Init::Auto;
+        }
+    }
+
+    static std::string initializationToString(nn::make::Init init) {
+        switch (init) {
+            case nn::make::Init::Xavier:
+                return "xavier";
+            case nn::make::Init::He:
+                return "he";
+            case nn::make::Init::Range:
+                return "range";
+            default:
+                return "auto";
+        }
+    }
+
+    static nn::CsvCodec::Encoding stringToEncoding(const std::string &encoding) {
+        if (encoding == "oneHot") {
+            return nn::CsvCodec::Encoding::OneHot;
+        } else {
+            return nn::CsvCodec::Encoding::Label;
+        }
+    }
+
     static nn::loss::function_t stringToLossFunction(const std::string &function) {
         if (function == "mse") {
             return nn::loss::mse;
+        } else if (function == "cross-entropy") {
+            return nn::loss::crossEntropy;
         } else {
             return nn::loss::sse;
         }
@@ -50,11 +186,16 @@ private:
         CALL_JS_FUNC("onDimensionsSet")
     }
 
-    void _setLearningRate(double learningRate) {
+    void _setLearningRate(nn::real_t learningRate) {
         this->alpha = learningRate;
         CALL_JS_FUNC("onLearningRateSet")
     }
 
+    void _setBatchSize(std::size_t size) {
+        this->batchSize = size > 0 ? size : 1;
+        CALL_JS_FUNC("onBatchSizeSet")
+    }
+
     void _setActivationFunction(const std::string &function) {
         this->actFunction = function;
         CALL_JS_FUNC("onActivationFunctionSet")
@@ -75,6 +216,7 @@ public:
      * On initialization, events are triggered sequentially:
      * - `onDimensionsSet`
      * - `onLearningRateSet`
+     * - `onBatchSizeSet`
      * - `onActivationFunctionSet`
      * - `onLossFunctionSet`
      * - `onNetworkBuilt`
@@ -82,6 +224,7 @@ public:
     void init() {
         _setDimensions({4, 3, 4});
         _setLearningRate(0.01);
+        _setBatchSize(1);
         _setActivationFunction("tanh");
         _setLossFunction("sse");
         build();
@@ -89,11 +232,13 @@ public:
 
     /**
      * Builds the module and triggers `onNetworkBuilt` event.
+     * Once an initialization seed is set, every build starts from the same weights for the same options.
      */
     void build() {
         nn::act::Function act = stringToActivationFunction(actFunction);
         nn::loss::function_t loss = stringToLossFunction(lossFunction);
-        module.setNetwork(nn::make::network(dimensions, act, loss));
+        if (initializationSeed) { nn::make::seed(*initializationSeed); }
+        module.setNetwork(nn::make::network(dimensions, act, loss, initialization));
         module.setLearningRate(alpha);
         CALL_JS_FUNC("onNetworkBuilt")
     }
@@ -107,15 +252,108 @@ public:
         return dimensions;
     }
 
-    void setLearningRate(double learningRate) {
+    void setLearningRate(nn::real_t learningRate) {
         _setLearningRate(learningRate);
         module.setLearningRate(alpha);
     }
 
-    [[nodiscard]] double getLearningRate() const {
+    [[nodiscard]] nn::real_t getLearningRate() const {
         return alpha;
     }
 
+    void setBatchSize(std::size_t size) {
+        _setBatchSize(size);
+    }
+
+    [[nodiscard]] std::size_t getBatchSize() const {
+        return batchSize;
+    }
+
+    /**
+     * Threads are only available when the module is built with `NN_WASM_THREADS`.
+     * Otherwise training always runs on a single thread.
+     */
+    void setThreads(std::size_t count) {
+        module.setThreads(count);
+    }
+
+    [[nodiscard]] std::size_t getThreads() const {
+        return module.getThreads();
+    }
+
+    void setParallelMode(const std::string &mode) {
+        module.setParallelMode(stringToParallelMode(mode));
+    }
+
+    [[nodiscard]] std::string getParallelMode() const {
+        return module.getParallelMode() == nn::Module::ParallelMode::Hogwild ? "hogwild" : "sync";
+    }
+
+    void setDeterministic(bool value) {
+        module.setDeterministic(value);
+    }
+
+    [[nodiscard]] bool isDeterministic() const {
+        return module.isDeterministic();
+    }
+
+    /**
+     * Resets the optimizer state, the network keeps its parameters.
+     * @param optimizer The update rule: `sgd`, `momentum`, `nesterov`, `rmsprop` or `adam`.
+     */
+    void setOptimizer(const std::string &optimizer) {
+        module.setOptimizer(stringToOptimizer(optimizer));
+    }
+
+    [[nodiscard]] std::string getOptimizer() const {
+        return optimizerToString(module.getOptimizer());
+    }
+
+    /**
+     * @param sampling The order of the training rows in every epoch:
+     * `sequential`, `shuffle`, `stratified` or `bootstrap`.
+     */
+    void setSampling(const std::string &sampling) {
+        module.setSampling(stringToSampling(sampling));
+    }
+
+    [[nodiscard]] std::string getSampling() const {
+        return samplingToString(module.getSampling());
+    }
+
+    void setSeed(std::uint32_t seed) {
+        module.setSeed(seed);
+    }
+
+    /**
+     * Rebuilds the network with the given initialization.
+     * @param init The initialization scheme: `auto`, `xavier`, `he` or `range`.
+     */
+    void setInitialization(const std::string &init) {
+        this->initialization = stringToInitialization(init);
+        build();
+    }
+
+    [[nodiscard]] std::string getInitialization() const {
+        return initializationToString(initialization);
+    }
+
+    /**
+     * Rebuilds the network from the given seed, and every following build too.
+     */
+    void setInitializationSeed(std::uint32_t seed) {
+        this->initializationSeed = seed;
+        build();
+    }
+
+    static void setActivationAccuracy(const std::string &accuracy) {
+        nn::act::setAccuracy(accuracy == "fast" ? nn::act::Accuracy::Fast : nn::act::Accuracy::Exact);
+    }
+
+    static std::string getActivationAccuracy() {
+        return nn::act::getAccuracy() == nn::act::Accuracy::Fast ? "fast" : "exact";
+    }
+
     void setActivationFunction(const std::string &function) {
         _setActivationFunction(function);
         build();
@@ -134,6 +372,13 @@ public:
         return lossFunction;
     }
 
+    /**
+     * @return The compute precision the module was built with, `float32` or `float64`.
+     */
+    [[nodiscard]] static std::string getPrecision() {
+        return sizeof(nn::real_t) == sizeof(float) ? "float32" : "float64";
+    }
+
     [[nodiscard]] nn::vvvd_t getWeights() const {
         return module.getWeights();
     }
@@ -142,8 +387,104 @@ public:
         return module.getBiases();
     }
 
+    /**
+     * Resizes the shared buffer used to pass datasets without copying them element by element.
+     * Javascript writes the row-major values into the heap at the returned address,
+     * as a `Float32Array` or `Float64Array` depending on `getPrecision`, then calls one of
+     * `setTrainInputBuffer`, `setTrainOutputBuffer`, `setTestInputBuffer` or `setTestOutputBuffer`.
+     *
+     * @param size The number of values.
+     * @return The address of the buffer in the WASM heap.
+     */
+    std::uintptr_t allocateBuffer(std::size_t size) {
+        buffer.resize(size);
+        return reinterpret_cast<std::uintptr_t>(buffer.data());
+    }
+
+    /**
+     * @return Whether the network has a layer with the given index, indices come unchecked from Javascript.
+     */
+    [[nodiscard]] bool hasLayer(std::size_t layer) const {
+        return layer + 1 < dimensions.size();
+    }
+
+    /**
+     * @return Whether the shared buffer holds at least one row of the given shape, without overflowing.
+     */
+    [[nodiscard]] bool holds(std::size_t rows, std::size_t columns) const {
+        return rows != 0 && columns != 0 && rows <= buffer.size() / columns;
+    }
+
+    /**
+     * Sets the training input from the shared buffer. Triggers `onTrainInputSet` event.
+     * @return False when the shape doesn't fit the buffer, the training input is then left unchanged.
+     */
+    bool setTrainInputBuffer(std::size_t rows, std::size_t columns) {
+        if (!holds(rows, columns)) { return false; }
+        module.setTrainInput(buffer.data(), rows, columns);
+        trainInputRows = rows;
+        CALL_JS_FUNC("onTrainInputSet")
+        return true;
+    }
+
+    /**
+     * Sets the training output from the shared buffer. Triggers `onTrainOutputSet` event.
+     * @return False when the shape doesn't fit the buffer, the training output is then left unchanged.
+     */
+    bool setTrainOutputBuffer(std::size_t rows, std::size_t columns) {
+        if (!holds(rows, columns)) { return false; }
+        module.setTrainOutput(buffer.data(), rows, columns);
+        trainOutputRows = rows;
+        CALL_JS_FUNC("onTrainOutputSet")
+        return true;
+    }
+
+    /**
+     * Sets the testing input from the shared buffer. Triggers `onTestInputSet` event.
+     * @return False when the shape doesn't fit the buffer, the testing input is then left unchanged.
+     */
+    bool setTestInputBuffer(std::size_t rows, std::size_t columns) {
+        if (!holds(rows, columns)) { return false; }
+        module.setTestInput(buffer.data(), rows, columns);
+        testInputRows = rows;
+        CALL_JS_FUNC("onTestInputSet")
+        return true;
+    }
+
+    /**
+     * Sets the testing output from the shared buffer. Triggers `onTestOutputSet` event.
+     * @return False when the shape doesn't fit the buffer, the testing output is then left unchanged.
+     */
+    bool setTestOutputBuffer(std::size_t rows, std::size_t columns) {
+        if (!holds(rows, columns)) { return false; }
+        module.setTestOutput(buffer.data(), rows, columns);
+        testOutputRows = rows;
+        CALL_JS_FUNC("onTestOutputSet")
+        return true;
+    }
+
+    /**
+     * @param layer The index of the layer.
+     * @return A view over the weights of the layer, one row per neuron and one column per input,
+     * or null when the network has no such layer.
+     */
+    [[nodiscard]] emscripten::val getWeightsView(std::size_t layer) const {
+        if (!hasLayer(layer)) { return emscripten::val::null(); }
+        return matrix(module.getWeights(layer).data(), dimensions[layer + 1], dimensions[layer]);
+    }
+
+    /**
+     * @param layer The index of the layer.
+     * @return A view over the biases of the layer, as a single row, or null when the network has no such layer.
+     */
+    [[nodiscard]] emscripten::val getBiasesView(std::size_t layer) const {
+        if (!hasLayer(layer)) { return emscripten::val::null(); }
+        return matrix(module.getBiases(layer).data(), 1, dimensions[layer + 1]);
+    }
+
     void setTrainInput(const nn::vvd_t &data) {
         module.setTrainInput(data);
+        trainInputRows = data.size();
         CALL_JS_FUNC("onTrainInputSet")
     }
 
@@ -153,11 +494,13 @@ public:
 
     void clearTrainInput() {
         module.setTrainInput({});
+        trainInputRows = 0;
         CALL_JS_FUNC("onTrainInputCleared")
     }
 
     void setTrainOutput(const nn::vvd_t &data) {
         module.setTrainOutput(data);
+        trainOutputRows = data.size();
         CALL_JS_FUNC("onTrainOutputSet")
     }
 
@@ -167,11 +510,13 @@ public:
 
     void clearTrainOutput() {
         module.setTrainOutput({});
+        trainOutputRows = 0;
         CALL_JS_FUNC("onTrainOutputCleared")
     }
 
     void setTestInput(const nn::vvd_t &data) {
         module.setTestInput(data);
+        testInputRows = data.size();
         CALL_JS_FUNC("onTestInputSet")
     }
 
@@ -181,11 +526,13 @@ public:
 
     void clearTestInput() {
         module.setTestInput({});
+        testInputRows = 0;
         CALL_JS_FUNC("onTestInputCleared")
     }
 
     void setTestOutput(const nn::vvd_t &data) {
         module.setTestOutput(data);
+        testOutputRows = data.size();
         CALL_JS_FUNC("onTestOutputSet")
     }
 
@@ -195,21 +542,192 @@ public:
 
     void clearTestOutput() {
         module.setTestOutput({});
+        testOutputRows = 0;
         CALL_JS_FUNC("onTestOutputCleared")
     }
 
+    /**
+     * Parses and encodes a training input CSV file, fitting the input codec on it.
+     * Triggers `onTrainInputSet` event.
+     *
+     * @param csv The content of the file.
+     * @param encoding The encoding of categorical columns, `label` or `oneHot`.
+     */
+    void setTrainInputCsv(const std::string &csv, const std::string &encoding) {
+        inputCodec = nn::CsvCodec(stringToEncoding(encoding));
+        setTrainInput(inputCodec.fit(csv, "Input"));
+    }
+
+    /**
+     * Parses and encodes a training output CSV file, fitting the output codec on it.
+     * Triggers `onTrainOutputSet` event.
+     *
+     * @param csv The content of the file.
+     * @param encoding The encoding of categorical columns, `label` or `oneHot`.
+     */
+    void setTrainOutputCsv(const std::string &csv, const std::string &encoding) {
+        outputCodec = nn::CsvCodec(stringToEncoding(encoding));
+        setTrainOutput(outputCodec.fit(csv, "Output"));
+    }
+
+    /**
+     * Parses a testing input CSV file and encodes it like the training input.
+     * Triggers `onTestInputSet` event.
+     *
+     * @param csv The content of the file.
+     */
+    void setTestInputCsv(const std::string &csv) {
+        setTestInput(inputCodec.encode(csv));
+    }
+
+    /**
+     * Parses a testing output CSV file and encodes it like the training output.
+     * Triggers `onTestOutputSet` event.
+     *
+     * @param csv The content of the file.
+     */
+    void setTestOutputCsv(const std::string &csv) {
+        setTestOutput(outputCodec.encode(csv));
+    }
+
+    /**
+     * @return The number of rows of each dataset, as `trainInput`, `trainOutput`, `testInput` and `testOutput`.
+     */
+    [[nodiscard]] emscripten::val getRows() const {
+        emscripten::val res = emscripten::val::object();
+        res.set("trainInput", trainInputRows);
+        res.set("trainOutput", trainOutputRows);
+        res.set("testInput", testInputRows);
+        res.set("testOutput", testOutputRows);
+        return res;
+    }
+
+    [[nodiscard]] std::vector<std::string> getInputHeaders(bool encoded) const {
+        return inputCodec.getHeaders(encoded);
+    }
+
+    [[nodiscard]] std::vector<std::string> getOutputHeaders(bool encoded) const {
+        return outputCodec.getHeaders(encoded);
+    }
+
     nn::vd_t trainFor(std::size_t epochs) {
-        return module.train(epochs);
+        return module.train(epochs, batchSize);
     }
 
     nn::vvd_t trainAndTestFor(std::size_t epochs) {
-        return pairToVector(module.trainAndTest(epochs));
+        return pairToVector(module.trainAndTest(epochs, batchSize));
+    }
+
+    /**
+     * Trains epoch by epoch, writing the errors of every epoch into the progress ring as they're computed.
+     * Stops early when `cancelTraining` is called, which takes effect between epochs.
+     *
+     * @param epochs The maximum number of epochs.
+     * @param withTest Whether to test after every epoch, otherwise the testing error is NaN.
+     * @return The number of epochs trained.
+     */
+    std::size_t trainChunk(std::size_t epochs, bool withTest) {
+        cancelled = false;
+        std::size_t epoch = 0;
+        for (; epoch < epochs && !cancelled; ++epoch) {
+            auto slot = 2 * (progressCount % progressCapacity);
+            progress[slot] = module.train(1, batchSize)[0];
+            progress[slot + 1] = withTest ? module.test() : std::numeric_limits<nn::real_t>::quiet_NaN();
+            ++progressCount;
+        }
+        return epoch;
+    }
+
+    /**
+     * Stops `trainChunk` after the current epoch. Only reaches a running chunk from another thread
+     * in builds with shared memory, otherwise it applies once the pending messages are handled.
+     */
+    void cancelTraining() {
+        cancelled = true;
+    }
+
+    /**
+     * @return A view over the progress ring, one row of training and testing errors per epoch.
+     * The row of epoch `i` is `i % rows`, only the latest `rows` epochs are kept.
+     */
+    [[nodiscard]] emscripten::val getProgressView() const {
+        return matrix(progress.data(), progressCapacity, 2);
+    }
+
+    /**
+     * @return The number of epochs written into the progress ring since the last reset.
+     */
+    [[nodiscard]] std::size_t getProgressCount() const {
+        return progressCount;
+    }
+
+    void resetProgress() {
+        progressCount = 0;
+    }
+
+    /**
+     * Replaces the parameters of a layer with the content of the shared buffer,
+     * the row-major weights followed by the biases.
+     *
+     * @param layer The index of the layer.
+     * @return False when the network has no such layer or the buffer is too small, nothing is changed then.
+     */
+    bool setLayerBuffer(std::size_t layer) {
+        if (!hasLayer(layer) || !holds(dimensions[layer] + 1, dimensions[layer + 1])) { return false; }
+        module.setParameters(layer, buffer.data(), buffer.data() + dimensions[layer] * dimensions[layer + 1]);
+        return true;
+    }
+
+    /**
+     * Training counters, only collected when the module is built with `NN_PROFILING`.
+     * @return An object with `enabled`, `samples`, `samplesPerSecond`, and the `seconds` and `allocations`
+     * of every phase keyed by name: `forward`, `loss`, `backward`, `update`, `normalization`,
+     * `testNormalization` and `epoch`.
+     */
+    [[nodiscard]] emscripten::val getProfile() const {
+        using Phase = nn::Profiler::Phase;
+        static const std::pair<const char *, Phase> phases[] = {
+                {"forward",           Phase::Forward},
+                {"loss",              Phase::Loss},
+                {"backward",          Phase::Backward},
+                {"update",            Phase::Update},
+                {"normalization",     Phase::Normalization},
+                {"testNormalization", Phase::TestNormalization},
+                {"epoch",             Phase::Epoch}
+        };
+        nn::Profiler profile = module.getProfile();
+        emscripten::val seconds = emscripten::val::object();
+        emscripten::val allocations = emscripten::val::object();
+        for (const auto &[name, phase]: phases) {
+            seconds.set(name, profile.getSeconds(phase));
+            allocations.set(name, profile.getAllocations(phase));
+        }
+        emscripten::val res = emscripten::val::object();
+        res.set("enabled", nn::Profiler::enabled);
+        res.set("samples", profile.getSamples());
+        res.set("samplesPerSecond", profile.getSamplesPerSecond());
+        res.set("seconds", seconds);
+        res.set("allocations", allocations);
+        return res;
+    }
+
+    void resetProfile() {
+        module.resetProfile();
     }
 
     [[nodiscard]] nn::vvd_t getPredictions() const {
         return module.predict();
     }
 
+    /**
+     * Predicts the testing dataset into a buffer kept by the controller.
+     * @return A view over the predictions, one row per testing row, valid until the next call.
+     */
+    emscripten::val getPredictionsView() {
+        module.predict(predictions);
+        return matrix(predictions.data(), predictions.size() / dimensions.back(), dimensions.back());
+    }
+
     [[nodiscard]] nn::vvd_t getCustomPredictions(const nn::vvd_t &data) const {
         return module.predict(data);
     }
@@ -220,9 +738,10 @@ EMSCRIPTEN_BINDINGS(my_module) {
 
     register_vector<int>("VecInt");
     register_vector<nn::ui_t>("VecUInt");
-    register_vector<double>("VecNum");
+    register_vector<nn::real_t>("VecNum");
     register_vector<nn::vd_t>("VecVecNum");
     register_vector<nn::vvd_t>("VecVecVecNum");
+    register_vector<std::string>("VecString");
 
     class_<NetworkController>("Network")
             .constructor<>()
@@ -232,12 +751,39 @@ EMSCRIPTEN_BINDINGS(my_module) {
             .function("getDimensions", &NetworkController::getDimensions)
             .function("setLearningRate", &NetworkController::setLearningRate)
             .function("getLearningRate", &NetworkController::getLearningRate)
+            .function("setBatchSize", &NetworkController::setBatchSize)
+            .function("getBatchSize", &NetworkController::getBatchSize)
+            .function("setThreads", &NetworkController::setThreads)
+            .function("getThreads", &NetworkController::getThreads)
+            .function("setParallelMode", &NetworkController::setParallelMode)
+            .function("getParallelMode", &NetworkController::getParallelMode)
+            .function("setDeterministic", &NetworkController::setDeterministic)
+            .function("isDeterministic", &NetworkController::isDeterministic)
+            .function("setOptimizer", &NetworkController::setOptimizer)
+            .function("getOptimizer", &NetworkController::getOptimizer)
+            .function("setSampling", &NetworkController::setSampling)
+            .function("getSampling", &NetworkController::getSampling)
+            .function("setSeed", &NetworkController::setSeed)
+            .function("setInitialization", &NetworkController::setInitialization)
+            .function("getInitialization", &NetworkController::getInitialization)
+            .function("setInitializationSeed", &NetworkController::setInitializationSeed)
+            .class_function("setActivationAccuracy", &NetworkController::setActivationAccuracy)
+            .class_function("getActivationAccuracy", &NetworkController::getActivationAccuracy)
             .function("setActivationFunction", &NetworkController::setActivationFunction)
             .function("getActivationFunction", &NetworkController::getActivationFunction)
             .function("setLossFunction", &NetworkController::setLossFunction)
             .function("getLossFunction", &NetworkController::getLossFunction)
+            .class_function("getPrecision", &NetworkController::getPrecision)
             .function("getWeights", &NetworkController::getWeights)
             .function("getBiases", &NetworkController::getBiases)
+            .function("allocateBuffer", &NetworkController::allocateBuffer)
+            .function("setTrainInputBuffer", &NetworkController::setTrainInputBuffer)
+            .function("setTrainOutputBuffer", &NetworkController::setTrainOutputBuffer)
+            .function("setTestInputBuffer", &NetworkController::setTestInputBuffer)
+            .function("setTestOutputBuffer", &NetworkController::setTestOutputBuffer)
+            .function("getWeightsView", &NetworkController::getWeightsView)
+            .function("getBiasesView", &NetworkController::getBiasesView)
+            .function("setLayerBuffer", &NetworkController::setLayerBuffer)
             .function("setTrainInput", &NetworkController::setTrainInput)
             .function("getTrainInput", &NetworkController::getTrainInput)
             .function("clearTrainInput", &NetworkController::clearTrainInput)
@@ -250,9 +796,24 @@ EMSCRIPTEN_BINDINGS(my_module) {
             .function("setTestOutput", &NetworkController::setTestOutput)
             .function("getTestOutput", &NetworkController::getTestOutput)
             .function("clearTestOutput", &NetworkController::clearTestOutput)
+            .function("setTrainInputCsv", &NetworkController::setTrainInputCsv)
+            .function("setTrainOutputCsv", &NetworkController::setTrainOutputCsv)
+            .function("setTestInputCsv", &NetworkController::setTestInputCsv)
+            .function("setTestOutputCsv", &NetworkController::setTestOutputCsv)
+            .function("getRows", &NetworkController::getRows)
+            .function("getInputHeaders", &NetworkController::getInputHeaders)
+            .function("getOutputHeaders", &NetworkController::getOutputHeaders)
             .function("trainFor", &NetworkController::trainFor)
             .function("trainAndTestFor", &NetworkController::trainAndTestFor)
             .function("getPredictions", &NetworkController::getPredictions)
+            .function("trainChunk", &NetworkController::trainChunk)
+            .function("cancelTraining", &NetworkController::cancelTraining)
+            .function("getProgressView", &NetworkController::getProgressView)
+            .function("getProgressCount", &NetworkController::getProgressCount)
+            .function("resetProgress", &NetworkController::resetProgress)
+            .function("getProfile", &NetworkController::getProfile)
+            .function("resetProfile", &NetworkController::resetProfile)
+            .function("getPredictionsView", &NetworkController::getPredictionsView)
             .function("getCustomPredictions", &NetworkController::getCustomPredictions);
 }
 
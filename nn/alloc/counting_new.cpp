@@ -0,0 +1,91 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include "profiler.h"
+
+#include <cstdlib>
+#include <new>
+
+/*
+ * Replaces every form of the global operator new and delete to count the allocations of the profiled phases.
+ * Only compiled into the executables that link the nn_alloc_counter object library in profiling builds.
+ */
+
+namespace {
+    void *allocate(std::size_t size, std::size_t alignment) {
+        nn::Profiler::countAllocation();
+        if (size == 0) { size = 1; }
+        void *p;
+        if (alignment <= alignof(std::max_align_t)) {
+            p = std::malloc(size);
+        } else {
+            // aligned_alloc wants a size that's a multiple of the alignment
+            p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+        }
+        return p;
+    }
+
+    void *allocateOrThrow(std::size_t size, std::size_t alignment) {
+        if (void *p = allocate(size, alignment)) { return p; }
+        throw std::bad_alloc();
+    }
+}
+
+void *operator new(std::size_t size) {
+    return allocateOrThrow(size, alignof(std::max_align_t));
+}
+
+void *operator new[](std::size_t size) {
+    return allocateOrThrow(size, alignof(std::max_align_t));
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+    return allocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    return allocate(size, alignof(std::max_align_t));
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+    return allocate(size, alignof(std::max_align_t));
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+// malloc and aligned_alloc both release with free, so every delete is the same
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete[](void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+
+void operator delete[](void *p, std::align_val_t) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+void operator delete(void *p, const std::nothrow_t &) noexcept { std::free(p); }
+
+void operator delete[](void *p, const std::nothrow_t &) noexcept { std::free(p); }
+
+void operator delete(void *p, std::align_val_t, const std::nothrow_t &) noexcept { std::free(p); }
+
+void operator delete[](void *p, std::align_val_t, const std::nothrow_t &) noexcept { std::free(p); }
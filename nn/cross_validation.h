@@ -0,0 +1,85 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#ifndef FRUIT_CLASSIFIER_WASM_CROSS_VALIDATION_H
+#define FRUIT_CLASSIFIER_WASM_CROSS_VALIDATION_H
+
+#include <cstdint>
+#include "nn.h"
+#include "module.h"
+
+/**
+ * The training rows of a base module are shuffled once and cut into K folds of nearly equal size.
+ * Every fold trains a copy of the base module on the other folds and tests on its own rows, see
+ * `Module::holdOut`. The copies share the training data of the base, folds are only index lists.
+ *
+ * Every fold starts from the network of the base module, so the folds differ only by their data.
+ * Folds are trained at the same time, each on a single thread. The min-max parameters are those
+ * of the whole training data, shared by all the folds.
+ */
+class nn::CrossValidation {
+public:
+    /**
+     * The error curves of one fold, one value per epoch.
+     */
+    struct Fold {
+        vd_t trainErrors;
+        vd_t testErrors;
+    };
+
+    struct Result {
+        std::vector<Fold> folds;
+        /**
+         * Training errors averaged over the folds, one per epoch.
+         */
+        vd_t trainErrors;
+        /**
+         * Testing errors averaged over the folds, one per epoch.
+         */
+        vd_t testErrors;
+    };
+
+private:
+    Module base;
+    std::size_t k;
+    std::size_t threads = 0;
+    std::uint32_t seed = 0;
+
+public:
+    /**
+     * Constructs a cross-validation of a module.
+     * @param module The module holding the training data, its network and settings.
+     * @param folds The number of folds, at least 2 and at most the number of training rows.
+     */
+    CrossValidation(const Module &module, std::size_t folds);
+
+    /**
+     * Sets the number of folds trained at the same time.
+     * @param count The number of workers. Zero means one worker per hardware thread, the default.
+     */
+    void setThreads(std::size_t count);
+
+    [[nodiscard]] std::size_t getThreads() const;
+
+    /**
+     * Sets the seed of the shuffle that assigns the rows to the folds. Default is 0.
+     * @param value The seed of the random generator.
+     */
+    void setSeed(std::uint32_t value);
+
+    /**
+     * @return The indices of the testing rows of every fold, in ascending order.
+     */
+    [[nodiscard]] std::vector<std::vector<std::size_t>> folds() const;
+
+    /**
+     * Trains and tests every fold for the given number of epochs.
+     * @param epochs The number of epochs.
+     * @param batchSize The number of samples in each batch. Default is 1.
+     * @return The error curves of every fold and their average.
+     */
+    [[nodiscard]] Result run(std::size_t epochs, std::size_t batchSize = 1) const;
+};
+
+#endif //FRUIT_CLASSIFIER_WASM_CROSS_VALIDATION_H
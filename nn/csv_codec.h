@@ -0,0 +1,162 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#ifndef FRUIT_CLASSIFIER_WASM_CSV_CODEC_H
+#define FRUIT_CLASSIFIER_WASM_CSV_CODEC_H
+
+#include "nn.h"
+
+#include <istream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Files follow the layout of the web datasets: comma separated values, one row per line,
+ * without quoting. Blank lines are skipped and missing trailing fields are read as empty.
+ *
+ * The first row is taken as headers when none of its values is numeric.
+ * A column is categorical when any of its values isn't numeric, its categories are indexed
+ * in order of first appearance. Empty values in numeric columns are read as zero.
+ */
+class nn::CsvCodec {
+public:
+    /**
+     * How categorical columns are turned into numbers.
+     */
+    enum class Encoding {
+        /**
+         * One value per column, the index of the category.
+         */
+        Label,
+        /**
+         * One value per category, 1 for the category of the row and 0 for the others.
+         */
+        OneHot
+    };
+
+    /**
+     * Number of characters read from a stream at once.
+     */
+    static constexpr std::size_t chunkSize = 1 << 16;
+
+private:
+    struct Column {
+        std::string header;
+        bool categorical = false;
+        std::vector<std::string> categories;
+        std::unordered_map<std::string, std::size_t> index;
+
+        /**
+         * @return The index of the category, which is added if it's new.
+         */
+        std::size_t add(const std::string &category);
+    };
+
+    /**
+     * Rows of one value per column, holding category indices for categorical columns.
+     */
+    struct Table {
+        std::size_t width = 0;
+        vd_t values;
+    };
+
+    Encoding encoding;
+    std::vector<Column> columns;
+    bool headers = false;
+
+    /**
+     * Learns the headers and categories of the rows, and stores them as a table.
+     */
+    template<typename Source>
+    Table learn(Source &&source, const std::string &headerPrefix);
+
+    /**
+     * Stores the rows as a table using the learned categories.
+     */
+    template<typename Source>
+    Table read(Source &&source) const;
+
+    /**
+     * Expands a table into encoded rows.
+     */
+    [[nodiscard]] vvd_t expand(const Table &table) const;
+
+public:
+    /**
+     * Constructs an empty codec, to be fitted on the training data.
+     *
+     * @param encoding How categorical columns are encoded.
+     */
+    explicit CsvCodec(Encoding encoding = Encoding::Label);
+
+    /**
+     * Learns the headers and categorical columns of a CSV file, then encodes it.
+     * The stream is parsed in chunks of `chunkSize` characters.
+     *
+     * @param in The stream to read the file from.
+     * @param headerPrefix Prefix of the generated headers when the file has none, followed by the column number.
+     * @return The encoded rows.
+     */
+    vvd_t fit(std::istream &in, const std::string &headerPrefix = "Col");
+
+    /**
+     * Learns the headers and categorical columns of CSV text, then encodes it.
+     *
+     * @param text The content of the file.
+     * @param headerPrefix Prefix of the generated headers when the file has none, followed by the column number.
+     * @return The encoded rows.
+     */
+    vvd_t fit(std::string_view text, const std::string &headerPrefix = "Col");
+
+    /**
+     * Encodes a CSV file with the columns learned by `fit`, so the values match the fitted data.
+     * The first row is skipped if the fitted data had headers. Categories not seen while fitting
+     * are encoded as -1 with label encoding and as all zeros with one-hot encoding.
+     * A codec that hasn't been fitted reads every column as numeric, and skips the first row
+     * when none of its values is numeric.
+     *
+     * @param in The stream to read the file from.
+     * @return The encoded rows.
+     */
+    [[nodiscard]] vvd_t encode(std::istream &in) const;
+
+    /**
+     * Encodes CSV text with the columns learned by `fit`.
+     *
+     * @param text The content of the file.
+     * @return The encoded rows.
+     */
+    [[nodiscard]] vvd_t encode(std::string_view text) const;
+
+    /**
+     * Decodes a row of encoded values, such as a network output, back into the values of the fitted columns.
+     * Label encoded categories are rounded to the nearest index and one-hot encoded categories are
+     * the largest of their values. Numeric columns are written with 15 significant digits.
+     *
+     * @param row The encoded values, as many as the encoded headers.
+     * @return One value per fitted column.
+     */
+    [[nodiscard]] std::vector<std::string> decode(const real_t *row) const;
+
+    /**
+     * @return The encoding of the categorical columns.
+     */
+    [[nodiscard]] Encoding getEncoding() const;
+
+    /**
+     * @param encoded Whether to name the encoded values, one per category for one-hot encoded columns.
+     * @return The headers of the columns, named `<header>_<category>` when encoded with one-hot encoding.
+     */
+    [[nodiscard]] std::vector<std::string> getHeaders(bool encoded = false) const;
+
+    /**
+     * @param column The index of the column.
+     * @return The categories of the column in order of their indices, empty for numeric columns.
+     */
+    [[nodiscard]] const std::vector<std::string> &getCategories(std::size_t column) const;
+};
+
+#endif //FRUIT_CLASSIFIER_WASM_CSV_CODEC_H
@@ -0,0 +1,149 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#ifndef FRUIT_CLASSIFIER_WASM_DATASET_H
+#define FRUIT_CLASSIFIER_WASM_DATASET_H
+
+#include "nn.h"
+#include "span.h"
+
+/**
+ * Samples are stored as given, one row after the other in a single buffer, so a batch of
+ * consecutive rows is one contiguous range of values.
+ *
+ * The normalized rows are computed on first use and kept until the rows or the min-max
+ * parameters change. Building the cache isn't synchronized, so the first use must happen
+ * before the dataset is shared between threads.
+ */
+class nn::Dataset {
+private:
+    vd_t values;
+    std::size_t columns = 0;
+    vpd_t minMax;
+    mutable vd_t normalizedValues;
+    mutable bool cached = false;
+
+public:
+    /**
+     * Constructs an empty dataset.
+     */
+    Dataset() = default;
+
+    /**
+     * Constructs a dataset holding a copy of the rows.
+     * @param rows The rows, all of the same width.
+     */
+    explicit Dataset(const vvd_t &rows);
+
+    /**
+     * Constructs a dataset holding a copy of stacked rows.
+     * @param data Pointer to the rows, stored row-major.
+     * @param rows The number of rows.
+     * @param width The number of values in each row.
+     */
+    Dataset(const real_t *data, std::size_t rows, std::size_t width);
+
+    /**
+     * Replaces the rows, keeping the min-max parameters.
+     * @param rows The rows, all of the same width.
+     */
+    void set(const vvd_t &rows);
+
+    /**
+     * Replaces the rows with stacked rows, keeping the min-max parameters.
+     * @param data Pointer to the rows, stored row-major.
+     * @param rows The number of rows.
+     * @param width The number of values in each row.
+     */
+    void set(const real_t *data, std::size_t rows, std::size_t width);
+
+    /**
+     * Drops the rows, keeping the min-max parameters.
+     */
+    void clear();
+
+    /**
+     * @return The number of rows.
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * @return The number of values in each row.
+     */
+    [[nodiscard]] std::size_t width() const;
+
+    /**
+     * @return Whether the dataset has no rows.
+     */
+    [[nodiscard]] bool empty() const;
+
+    /**
+     * @return All the rows, stored row-major.
+     */
+    [[nodiscard]] const vd_t &data() const;
+
+    /**
+     * @param index The index of the row.
+     * @return A view over the values of the row.
+     */
+    [[nodiscard]] csd_t row(std::size_t index) const;
+
+    /**
+     * @param from The index of the first row.
+     * @param to The index after the last row.
+     * @return A view over the rows in the range [from, to), stored row-major.
+     */
+    [[nodiscard]] csd_t rows(std::size_t from, std::size_t to) const;
+
+    /**
+     * @return A copy of the rows, one vector per row.
+     */
+    [[nodiscard]] vvd_t toRows() const;
+
+    /**
+     * Sets the min-max parameters to the range of every column of the rows.
+     */
+    void fitMinMax();
+
+    /**
+     * Replaces the min-max parameters, keeping the normalized rows if they are the same.
+     * @param params The min-max parameters, one pair per column.
+     */
+    void setMinMax(const vpd_t &params);
+
+    /**
+     * @return The min-max parameters, one pair per column.
+     */
+    [[nodiscard]] const vpd_t &getMinMax() const;
+
+    /**
+     * @return All the rows normalized with the min-max parameters, stored row-major.
+     */
+    [[nodiscard]] const vd_t &normalized() const;
+
+    /**
+     * @param from The index of the first row.
+     * @param to The index after the last row.
+     * @return A view over the normalized rows in the range [from, to), stored row-major.
+     */
+    [[nodiscard]] csd_t normalized(std::size_t from, std::size_t to) const;
+
+    /**
+     * Normalizes stacked rows with the min-max parameters.
+     * @param original Pointer to the rows to be normalized.
+     * @param out Pointer to the normalized rows. May be the same as original.
+     * @param n Total number of values.
+     */
+    void normalize(const real_t *original, real_t *out, std::size_t n) const;
+
+    /**
+     * De-normalizes stacked rows with the min-max parameters.
+     * @param processed Pointer to the rows to be denormalized.
+     * @param out Pointer to the denormalized rows. May be the same as processed.
+     * @param n Total number of values.
+     */
+    void denormalize(const real_t *processed, real_t *out, std::size_t n) const;
+};
+
+#endif //FRUIT_CLASSIFIER_WASM_DATASET_H
@@ -0,0 +1,126 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#ifndef FRUIT_CLASSIFIER_WASM_ENSEMBLE_H
+#define FRUIT_CLASSIFIER_WASM_ENSEMBLE_H
+
+#include <cstdint>
+#include "nn.h"
+#include "network.h"
+
+/**
+ * The members' layers are stacked: the neurons of a layer of every member form one wide layer, whose outputs
+ * hold the outputs of every member one after the other. Its weights are stored input-major, so each input
+ * adds one contiguous column of weights to the outputs of all the members, a long vectorized loop instead of
+ * a short dot product per neuron. The outputs of all the members are activated with one call per layer.
+ * The first layer of every member reads the same input row, the following layers read their member's slice
+ * of the previous outputs.
+ *
+ * Like the networks it's built from, the ensemble expects normalized inputs and returns normalized outputs.
+ */
+class nn::Ensemble {
+public:
+    /**
+     * How the outputs of the members are combined into the outputs of the ensemble.
+     */
+    enum class Aggregation {
+        /**
+         * The average of the outputs of the members.
+         */
+        Mean,
+        /**
+         * The fraction of the members voting for every class, a member votes for its largest output.
+         * For a single output it's the fraction of the members with an output of at least 0.5.
+         */
+        Vote
+    };
+
+private:
+    /**
+     * The layers of the same depth of all the members, stacked. The weight of input j for neuron n of
+     * member m is at j * members * size + m * size + n, biases are stored member after member.
+     */
+    struct Dense {
+        std::size_t inputs;
+        std::size_t size;
+        vd_t weights;
+        vd_t biases;
+        act::Function function;
+    };
+
+    std::size_t members;
+    std::vector<Dense> layers;
+    Aggregation aggregation;
+
+    /**
+     * Activates one stacked layer for stacked rows of inputs.
+     *
+     * @param layer The layer to be activated.
+     * @param shared Whether all the members read the same inputs, true for the first layer.
+     * @param inputs The stacked inputs of the layer.
+     * @param outputs The stacked outputs of all the members, resized to fit.
+     * @param last Whether the layer is the output layer.
+     */
+    void activate(const Dense &layer, bool shared, const vd_t &inputs, vd_t &outputs, bool last) const;
+
+    /**
+     * Combines the outputs of the members into the outputs of the ensemble.
+     */
+    void aggregate(const vd_t &stacked, vd_t &outputs) const;
+
+public:
+    /**
+     * Stacks the networks into an ensemble, the networks are only read.
+     * @param networks The members, all with the same dimensions and hidden activations. At least one.
+     * @param aggregation How the outputs of the members are combined. Default is Mean.
+     * @throws std::invalid_argument If there are no networks, or their dimensions or hidden activations differ.
+     */
+    explicit Ensemble(const std::vector<Network> &networks, Aggregation aggregation = Aggregation::Mean);
+
+    /**
+     * Trains the networks by bagging and stacks them. Every network is trained on its own bootstrap
+     * sample of the training data of the module, as many rows drawn with replacement as the data holds,
+     * on a copy of the module sharing its data (see `Module::setTrainRows`).
+     * Networks are trained at the same time on the threads set by `Module::setThreads`, each on one thread.
+     *
+     * @param module The module holding the training data and the training settings.
+     * @param networks The initial networks, usually built by `make::network`.
+     * @param epochs The number of epochs every network is trained for.
+     * @param batchSize The number of samples in each batch. Default is 1.
+     * @param seed The seed of the bootstrap samples. Default is 0.
+     * @return The ensemble of the trained networks.
+     */
+    static Ensemble bag(const Module &module, const std::vector<Network> &networks, std::size_t epochs,
+                        std::size_t batchSize = 1, std::uint32_t seed = 0);
+
+    /**
+     * @return The number of members.
+     */
+    [[nodiscard]] std::size_t getSize() const;
+
+    void setAggregation(Aggregation value);
+
+    [[nodiscard]] Aggregation getAggregation() const;
+
+    /**
+     * Makes predictions based on input data.
+     *
+     * @param inputs Stacked rows of normalized input values.
+     * @return Stacked rows of the aggregated outputs.
+     */
+    [[nodiscard]] vd_t predict(const vd_t &inputs) const;
+
+    /**
+     * Makes predictions based on input data, reusing the given buffers.
+     * No memory is allocated once the buffers are large enough.
+     *
+     * @param inputs Stacked rows of normalized input values.
+     * @param outputs Stacked rows of the aggregated outputs, resized to fit.
+     * @param buffer Buffer for the intermediate results.
+     * @param stacked Buffer for the outputs of all the members.
+     */
+    void predict(const vd_t &inputs, vd_t &outputs, vd_t &buffer, vd_t &stacked) const;
+};
+
+#endif //FRUIT_CLASSIFIER_WASM_ENSEMBLE_H
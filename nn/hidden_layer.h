@@ -24,11 +24,19 @@ public:
      * @param neurons The neurons of the layer.
      * @param function An activation function to be used for the neurons.
      */
-    explicit HiddenLayer(vn_t neurons, act::Function function);
+    explicit HiddenLayer(const vn_t &neurons, act::Function function);
 
-    [[nodiscard]] vd_t activate(const vd_t &inputs) const override;
+    /**
+     * @return The activation function of the layer.
+     */
+    [[nodiscard]] const act::Function &getFunction() const;
+
+    using Layer::activate;
+    using Layer::calculateGradients;
+
+    void activate(const vd_t &inputs, vd_t &outputs) const override;
 
-    [[nodiscard]] vd_t calculateGradients(const vd_t &intermediateGradients) const override;
+    void calculateGradients(const vd_t &intermediateGradients, vd_t &gradients) const override;
 };
 
 #endif //FRUIT_CLASSIFIER_WASM_HIDDEN_LAYER_H
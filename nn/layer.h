@@ -7,19 +7,102 @@
 
 #include "nn.h"
 #include "neuron.h"
+#include "optimizer.h"
+#include "span.h"
 
-class nn::Layer : public vn_t {
+/**
+ * All processing methods accept a mini-batch of samples as well as a single sample.
+ * A batch is a row-major matrix stored in one vector, one sample per row.
+ * The number of rows is deduced from the size of the given inputs.
+ * Outputs, cashes and gradients of a batch follow the same layout.
+ */
+class nn::Layer {
 protected:
+    /**
+     * Number of inputs for every neuron, which is the row length of the weights matrix.
+     */
+    std::size_t inputs;
+
+    /**
+     * Weights of all neurons stored as one contiguous row-major matrix.
+     * Row `i` holds the weights of neuron `i`.
+     */
+    vd_t weights;
+    vd_t biases;
+
     vd_t output_cash;
     vd_t gradient_cash;
 
+    /**
+     * Optimizer state shaped like the weights and the biases, see Optimizer.
+     * Empty when the optimizer doesn't keep it.
+     */
+    vd_t weightMoments;
+    vd_t biasMoments;
+    vd_t weightSquares;
+    vd_t biasSquares;
+
 public:
     /**
      * Constructor for the Layer class that initializes the layer with a given set of neurons.
+     * All neurons must have the same number of weights.
+     * Their weights are copied into the layer's weights matrix.
      *
      * @param n A vector of Neuron objects.
      */
-    explicit Layer(vn_t n);
+    explicit Layer(const vn_t &n);
+
+    /**
+     * @return The number of neurons in the layer.
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * @return The number of inputs for every neuron in the layer.
+     */
+    [[nodiscard]] std::size_t getInputSize() const;
+
+    /**
+     * @param neuron The index of the neuron.
+     * @return A view over the weights of the given neuron.
+     */
+    [[nodiscard]] csd_t getWeights(std::size_t neuron) const;
+
+    /**
+     * @param neuron The index of the neuron.
+     * @return A mutable view over the weights of the given neuron.
+     */
+    sd_t getWeights(std::size_t neuron);
+
+    /**
+     * @return The whole row-major weights matrix of the layer.
+     */
+    [[nodiscard]] const vd_t &getWeights() const;
+
+    /**
+     * @param neuron The index of the neuron.
+     * @return The bias of the given neuron.
+     */
+    [[nodiscard]] real_t getBias(std::size_t neuron) const;
+
+    /**
+     * @return The biases of all neurons in the layer.
+     */
+    [[nodiscard]] const vd_t &getBiases() const;
+
+    /**
+     * Builds a standalone copy of a neuron of the layer.
+     *
+     * @param neuron The index of the neuron.
+     * @return A Neuron object with the same weights and bias.
+     */
+    [[nodiscard]] Neuron getNeuron(std::size_t neuron) const;
+
+    /**
+     * Two layers are equal when they have identical weights and biases.
+     * Caches are not compared.
+     */
+    bool operator==(const Layer &other) const;
 
     /**
      * @return The latest cashed output result.
@@ -41,6 +124,22 @@ public:
      */
     [[nodiscard]] vd_t process(const vd_t &inputs) const;
 
+    /**
+     * Same as `process(inputs)` but writes into the given outputs vector.
+     * The outputs are resized to fit, no allocation happens once they have enough capacity.
+     *
+     * @param inputs A vector of input values to the layer.
+     * @param outputs A vector to hold the raw output values from each neuron.
+     */
+    void process(const vd_t &inputs, vd_t &outputs) const;
+
+    /**
+     * @param values A vector of stacked samples, each of the given width.
+     * @param width The width of a single row.
+     * @return The number of rows in the given values.
+     */
+    [[nodiscard]] static std::size_t rows(const vd_t &values, std::size_t width);
+
     /**
      * Processes the inputs through the layer by activating each neuron.
      * Activation function is applied to every output.
@@ -48,7 +147,17 @@ public:
      * @param inputs A vector of input values to the layer.
      * @return A vector of output values from each neuron.
      */
-    [[nodiscard]] virtual vd_t activate(const vd_t &inputs) const = 0;
+    [[nodiscard]] vd_t activate(const vd_t &inputs) const;
+
+    /**
+     * Same as `activate(inputs)` but writes into the given outputs vector.
+     * The outputs are resized to fit, no allocation happens once they have enough capacity.
+     * The inputs and outputs must not be the same vector.
+     *
+     * @param inputs A vector of input values to the layer.
+     * @param outputs A vector to hold the output values from each neuron.
+     */
+    virtual void activate(const vd_t &inputs, vd_t &outputs) const = 0;
 
     /**
      * Processes and caches the inputs through the layer by activating each neuron.
@@ -56,9 +165,9 @@ public:
      * during training.
      *
      * @param inputs A vector of input values to the layer.
-     * @return A vector of output values from each neuron.
+     * @return A reference to the cashed output values from each neuron.
      */
-    vd_t activateAndCache(const vd_t &inputs);
+    const vd_t &activateAndCache(const vd_t &inputs);
 
     /**
      * Abstract method for calculating the gradients for the layer. This method is designed to be
@@ -79,7 +188,17 @@ public:
      * @return A vector of final gradients for the current layer after applying the derivative of
      * the activation function.
      */
-    [[nodiscard]] virtual vd_t calculateGradients(const vd_t &intermediateGradients) const = 0;
+    [[nodiscard]] vd_t calculateGradients(const vd_t &intermediateGradients) const;
+
+    /**
+     * Same as `calculateGradients(intermediateGradients)` but writes into the given gradients vector.
+     * The gradients are resized to fit, no allocation happens once they have enough capacity.
+     *
+     * @param intermediateGradients A vector of gradients obtained from the `propagateErrorBackward` method of the
+     * next layer, or the desired values in the case of the output layer.
+     * @param gradients A vector to hold the final gradients for the current layer.
+     */
+    virtual void calculateGradients(const vd_t &intermediateGradients, vd_t &gradients) const = 0;
 
     /**
      * Calculates the gradients for the layer based on the intermediate gradients and caches them.
@@ -100,10 +219,10 @@ public:
      * @param intermediateGradients A vector of gradients obtained from the `propagateErrorBackward` method of the
      * next layer. These gradients are pre-derivative and need to be processed to obtain the final gradients.
      * In the case of the output layer these are the `target` or `desired` values.
-     * @return A vector of final gradients for the current layer after applying the derivative of
-     * the activation function. These gradients are also cached within the layer.
+     * @return A reference to the final gradients for the current layer after applying the derivative of
+     * the activation function. These gradients are cached within the layer.
      */
-    vd_t calculateGradientsAndCash(const vd_t &intermediateGradients);
+    const vd_t &calculateGradientsAndCash(const vd_t &intermediateGradients);
 
     /**
      * Propagates the error backward from the current layer to the previous layer in the network.
@@ -125,6 +244,86 @@ public:
      * weighted sum of the current layer's gradients and neuron weights.
      */
     [[nodiscard]] vd_t propagateErrorBackward() const;
+
+    /**
+     * Same as `propagateErrorBackward()` but writes into the given errors vector.
+     * The errors are resized to fit, no allocation happens once they have enough capacity.
+     *
+     * @param errors A vector to hold the preliminary gradients for the previous layer.
+     */
+    void propagateErrorBackward(vd_t &errors) const;
+
+    /**
+     * Uses the cashed gradients and the learning rate to adjust the weights and biases of every neuron.
+     * The same update as calling `Neuron::adjust(inputs, gradient, alpha)` on each neuron.
+     * For a batch the gradients of all rows are accumulated and averaged, then applied in one update.
+     *
+     * Note: This method uses the gradients cashed by the latest `calculateGradientsAndCash` method call.
+     *
+     * @param inputs Vector of input values that were passed to the layer.
+     * @param alpha Learning rate
+     */
+    void adjust(const vd_t &inputs, real_t alpha);
+
+    /**
+     * Adds the gradients of the weights and biases to the given accumulators, without updating the layer.
+     * For a batch the gradients of all rows are summed.
+     *
+     * Note: This method uses the gradients cashed by the latest `calculateGradientsAndCash` method call.
+     *
+     * @param inputs Vector of input values that were passed to the layer.
+     * @param weightGradients Accumulator shaped like the weights matrix.
+     * @param biasGradients Accumulator shaped like the biases vector.
+     */
+    void accumulate(const vd_t &inputs, vd_t &weightGradients, vd_t &biasGradients) const;
+
+    /**
+     * Applies accumulated gradients to the weights and biases: w -= rate * gradient.
+     *
+     * @param weightGradients Gradients shaped like the weights matrix.
+     * @param biasGradients Gradients shaped like the biases vector.
+     * @param rate The scale applied to the gradients, usually the learning rate divided by the batch size.
+     */
+    void apply(const vd_t &weightGradients, const vd_t &biasGradients, real_t rate);
+
+    /**
+     * Sizes the optimizer state for the given optimizer and sets it to zero.
+     * Must be called before `apply` with an optimizer, and again whenever the optimizer changes.
+     *
+     * @param optimizer The optimizer the state is kept for.
+     */
+    void resetOptimizer(const Optimizer &optimizer);
+
+    /**
+     * Applies accumulated gradients with an optimizer.
+     * Every parameter and its optimizer state are updated in one pass.
+     *
+     * @param weightGradients Gradients shaped like the weights matrix.
+     * @param biasGradients Gradients shaped like the biases vector.
+     * @param optimizer The optimizer the state was sized for by `resetOptimizer`.
+     * @param rate The learning rate.
+     * @param scale Multiplies the gradients, usually one over the batch size.
+     * @param step The number of updates including this one, starting at 1.
+     */
+    void apply(const vd_t &weightGradients, const vd_t &biasGradients, const Optimizer &optimizer,
+               real_t rate, real_t scale, std::size_t step);
+
+    /**
+     * Copies the weights and biases of a layer with the same dimensions.
+     * No allocation happens and the caches are left untouched.
+     *
+     * @param other The layer to copy the parameters from.
+     */
+    void setParameters(const Layer &other);
+
+    /**
+     * Copies the weights and biases from raw buffers.
+     * No allocation happens and the caches are left untouched.
+     *
+     * @param newWeights Pointer to the row-major weights matrix, one row per neuron.
+     * @param newBiases Pointer to the biases, one per neuron.
+     */
+    void setParameters(const real_t *newWeights, const real_t *newBiases);
 };
 
 #endif //FRUIT_CLASSIFIER_WASM_LAYER_H
@@ -0,0 +1,107 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#ifndef FRUIT_CLASSIFIER_WASM_MODEL_FILE_H
+#define FRUIT_CLASSIFIER_WASM_MODEL_FILE_H
+
+#include "nn.h"
+#include "network.h"
+#include "span.h"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * Binary model format, version 1. All values use the byte order and precision of the machine that wrote them,
+ * both are recorded in the header and checked on load.
+ *
+ * - Header: magic "NNMODEL", version, byte order mark, size of real_t, number of layers, loss function id.
+ * - Dimensions: one uint32 per layer plus one for the inputs, then one activation id per hidden layer.
+ * - Parameters: the row-major weights then the biases of every layer.
+ * - Normalization: the (min, max) pairs of the inputs, then of the outputs.
+ *
+ * Every section after the header starts on a 64-byte boundary, so the parameters can be used
+ * straight from the mapped pages by the vectorized kernels.
+ */
+class nn::ModelFile {
+private:
+    std::shared_ptr<const unsigned char> storage;
+    std::vector<std::size_t> dimensions;
+    vf_t functions;
+    loss::function_t lossFunction = nullptr;
+    std::vector<csd_t> weights;
+    std::vector<csd_t> biases;
+    vpd_t inputMinMax;
+    vpd_t outputMinMax;
+
+    ModelFile() = default;
+
+    /**
+     * Validates the header and builds the views over the sections of the mapped file.
+     * @return Whether the file holds a valid model.
+     */
+    bool parse(std::size_t length);
+
+public:
+    /**
+     * Maps a model file into memory, falling back to reading it when mapping isn't supported.
+     * Nothing is copied, the parameters are used from the mapped pages until the last copy
+     * of the returned object is destroyed.
+     *
+     * @param path The path of the model file.
+     * @return The opened model, or nothing if the file can't be read or isn't a valid model
+     * written with the same precision and byte order.
+     */
+    static std::optional<ModelFile> open(const std::string &path);
+
+    /**
+     * Writes a network and its normalization parameters in the binary model format.
+     * Only networks built from the built-in activation and loss functions can be written.
+     *
+     * @param path The path of the model file, replaced if it exists.
+     * @param network The network to be written.
+     * @param inputMinMax The min-max parameters of the inputs, empty for none.
+     * @param outputMinMax The min-max parameters of the outputs, empty for none.
+     * @return Whether the model was written.
+     */
+    static bool write(const std::string &path, const Network &network,
+                      const vpd_t &inputMinMax, const vpd_t &outputMinMax);
+
+    /**
+     * @return The dimensions of the network, the number of inputs first.
+     */
+    [[nodiscard]] const std::vector<std::size_t> &getDimensions() const;
+
+    /**
+     * @return The min-max parameters of the inputs, identity pairs if none were written.
+     */
+    [[nodiscard]] const vpd_t &getInputMinMax() const;
+
+    /**
+     * @return The min-max parameters of the outputs, identity pairs if none were written.
+     */
+    [[nodiscard]] const vpd_t &getOutputMinMax() const;
+
+    /**
+     * Builds a trainable network holding a copy of the parameters.
+     *
+     * @return The network stored in the file.
+     */
+    [[nodiscard]] Network toNetwork() const;
+
+    /**
+     * Predicts outputs straight from the mapped parameters, without building a network.
+     * Inputs are normalized and outputs de-normalized with the stored min-max parameters.
+     *
+     * @param inputs Pointer to the input rows, stored row-major.
+     * @param rows The number of input rows.
+     * @param outputs Pointer to a buffer with room for `rows` output rows.
+     */
+    void predict(const real_t *inputs, std::size_t rows, real_t *outputs) const;
+};
+
+#endif //FRUIT_CLASSIFIER_WASM_MODEL_FILE_H
@@ -5,62 +5,250 @@
 #ifndef FRUIT_CLASSIFIER_WASM_MODULE_H
 #define FRUIT_CLASSIFIER_WASM_MODULE_H
 
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <random>
 #include "nn.h"
 #include "network.h"
+#include "quantized_network.h"
+#include "model_file.h"
+#include "dataset.h"
+#include "thread_pool.h"
 
 class nn::Module {
-private:
+public:
     /**
-     * Manages the normalization and de-normalization of data.
-     * It stores the normalized data and the min-max values used for normalization.
+     * How the workers of the multi-threaded training share the network.
      */
-    class NormalizedData {
-        vvd_t normalized;
-        vpd_t minMax;
-
-    public:
+    enum class ParallelMode {
         /**
-         * Sets and normalizes the data.
-         * @param data The data to be normalized and set.
+         * Every batch is split between the workers. Each worker computes the gradients of its shard
+         * on its own copy of the network, the gradients are summed and applied in one update.
+         * Gives the same results as single-threaded batch training, up to the summation order.
+         * Small batches are split between fewer workers, see `minimumShard`.
          */
-        void set(const vvd_t &data);
+        Synchronous,
+        /**
+         * The training data is split between the workers for the whole epoch. Each worker trains on its
+         * shard in batches and applies its updates to the shared network as soon as it has them, without
+         * waiting for the others. Only one worker updates or reads a layer at a time, so the weights and
+         * the optimizer state stay consistent, but a worker's gradients may come from weights others have
+         * since updated and results are not reproducible.
+         */
+        Hogwild
+    };
 
+    /**
+     * The order in which the training rows are visited in every epoch.
+     * Orders are index permutations over the stored rows, the rows themselves are never moved.
+     */
+    enum class Sampling {
+        /**
+         * Every row once, in the order the rows were set.
+         */
+        Sequential,
         /**
-         * Gets the denormalized data.
-         * @return The denormalized data.
+         * Every row once, in a new random order every epoch.
          */
-        [[nodiscard]] vvd_t get() const;
+        Shuffle,
+        /**
+         * Every row once in a random order, with the rows of every class spread evenly over the epoch,
+         * so each batch keeps the class proportions of the whole set. The class of a row is its largest
+         * output, or for a single output whether it's in the upper half of the outputs range.
+         */
+        Stratified,
+        /**
+         * As many rows as the set holds, drawn at random with replacement.
+         */
+        Bootstrap
+    };
 
+    /**
+     * Compares a quantized network with the full precision network on the testing dataset.
+     * A prediction is correct when its largest output matches the largest desired output,
+     * or for a single output when it's within 0.5 of the desired value.
+     */
+    struct QuantizationReport {
+        /**
+         * Fraction of the testing rows predicted correctly by the full precision network.
+         */
+        real_t accuracy;
         /**
-         * Provides direct access to the normalized data.
-         * @return A reference to the normalized data.
+         * Fraction of the testing rows predicted correctly by the quantized network.
          */
-        [[nodiscard]] const vvd_t &use() const;
+        real_t quantizedAccuracy;
+        /**
+         * Largest absolute difference between the normalized outputs of both networks.
+         */
+        real_t maxDifference;
+    };
+
+private:
+    /**
+     * Number of rows each worker pushes through the network at once while predicting.
+     */
+    static constexpr std::size_t predictionChunk = 256;
+
+    /**
+     * Smallest number of rows a worker takes from a synchronous batch. Smaller batches are split between
+     * fewer workers, and a batch that can't give two workers that many rows is trained on the calling thread.
+     */
+    static constexpr std::size_t minimumShard = 4;
+
+    std::optional<Network> network;
+    real_t alpha = 0.01;
+
+    std::size_t threads = 1;
+    ParallelMode parallelMode = ParallelMode::Synchronous;
+    bool deterministic = true;
 
+    Optimizer optimizer;
+
+    Sampling sampling = Sampling::Sequential;
+    std::mt19937 random;
+
+    /**
+     * Indices of the training rows in the order of the current epoch, empty for sequential epochs.
+     */
+    std::vector<std::size_t> order;
+
+    /**
+     * Indices of the training rows trained on after `setTrainRows` or `holdOut`, and tested on after `holdOut`.
+     * Empty for all the training rows and the testing sets.
+     */
+    std::vector<std::size_t> trainRows;
+    std::vector<std::size_t> testRows;
+
+    /**
+     * The training and testing sets. The testing sets are normalized with the min-max parameters
+     * of the training sets, and keep their normalized rows between testing epochs.
+     * Copies of a module share the sets, a module replaces a shared set before changing it.
+     */
+    std::shared_ptr<Dataset> trainInput;
+    std::shared_ptr<Dataset> trainOutput;
+    std::shared_ptr<Dataset> testInput;
+    std::shared_ptr<Dataset> testOutput;
+
+    /**
+     * Counters of the phases run by the module itself, the network counts its training steps.
+     * Mutable since testing normalizes the testing data on its first call.
+     */
+    mutable Profiler profiler;
+
+    /**
+     * The workers of the multi-threaded training and prediction, started on first use and kept between
+     * epochs and calls until the number of threads changes. Copies of a module start their own workers.
+     */
+    struct Workers {
+        std::unique_ptr<ThreadPool> pool;
+        std::size_t size = 0;
         /**
-         * Uses the min-max values stored to normalize the given data.
-         * @param original The data to be normalized.
-         * @return The normalized data.
+         * The buffers of every worker predicting, kept so repeated predictions don't allocate.
          */
-        [[nodiscard]] vvd_t normalize(const vvd_t &original) const;
+        struct Prediction {
+            Network::Workspace workspace;
+            vd_t input;
+
+            explicit Prediction(const Network &network) : workspace(network) {}
+        };
+        std::vector<Prediction> predictions;
 
         /**
-         * Uses the min-max values stored to de-normalize the given data.
-         * @param processed The processed data to be denormalized.
-         * @return The denormalized data.
+         * The copy of the network a worker trains on, with its gradients and batch buffers.
+         */
+        struct Replica {
+            Network network;
+            Network::Gradients gradients;
+            vd_t inputs, outputs;
+            real_t loss = 0;
+
+            explicit Replica(const Network &network) : network(network), gradients(network) {}
+        };
+        /**
+         * The replicas of the training workers, kept between epochs and rebuilt for a new network.
+         */
+        std::vector<Replica> replicas;
+        /**
+         * The sum of the gradients of a synchronous batch.
+         */
+        std::optional<Network::Gradients> total;
+        /**
+         * One mutex per layer of the network, held by Hogwild workers while they read or update the layer.
+         */
+        std::vector<std::mutex> locks;
+        /**
+         * Held while the pool runs, a pool runs one task at a time.
          */
-        [[nodiscard]] vvd_t denormalize(const vvd_t &processed) const;
+        std::mutex mutex;
+
+        Workers() = default;
+
+        Workers(const Workers &) {}
+
+        Workers &operator=(const Workers &) { return *this; }
     };
 
-    std::optional<Network> network;
-    double alpha = 0.01;
+    mutable Workers workers;
+
+    /**
+     * @return The pool of `threads` workers, started or restarted if needed. The workers mutex must be held.
+     */
+    ThreadPool &pool() const;
+
+    /**
+     * Prepares the replicas, the gradient sum and the layer locks of the training workers,
+     * building them again if the network or the number of workers changed. The workers mutex must be held.
+     *
+     * @param count The number of workers.
+     */
+    void prepareReplicas(std::size_t count);
+
+    /**
+     * Adds the counters of the replicas to the network's and resets them. The workers mutex must be held.
+     */
+    void mergeProfiles();
+
+    /**
+     * Draws the order of the training rows for the next epoch with the current sampling strategy.
+     */
+    void sample();
+
+    /**
+     * Trains on every row of the current order, updating the network after each one.
+     * @return The average training error for the epoch.
+     */
+    real_t trainSamples();
 
-    NormalizedData trainInput;
-    NormalizedData trainOutput;
+    /**
+     * @return The number of rows visited in the current epoch.
+     */
+    [[nodiscard]] std::size_t epochSize() const;
+
+    /**
+     * Trains for one epoch on the calling thread.
+     * @param batchSize The number of samples in each batch.
+     * @return The average training error for the epoch.
+     */
+    real_t trainSerial(std::size_t batchSize);
+
+    /**
+     * Trains for one epoch on the workers of the given pool, using the current parallel mode.
+     * @param batchSize The number of samples in each batch.
+     * @param pool The workers to train on.
+     * @return The average training error for the epoch.
+     */
+    real_t trainParallel(std::size_t batchSize, ThreadPool &pool);
 
-    vvd_t testInput;
-    vvd_t testOutput;
+    real_t trainSynchronous(std::size_t batchSize, ThreadPool &pool);
+
+    real_t trainHogwild(std::size_t batchSize, ThreadPool &pool);
+
+    /**
+     * Normalizes the testing sets with the min-max parameters of the training sets.
+     */
+    void updateTestMinMax();
 
 public:
     /**
@@ -69,17 +257,23 @@ public:
     explicit Module();
 
     /**
-     * Constructs a Module with an existing network.
+     * Constructs a Module with an existing network, keeping the optimizer of the network.
      * @param network The neural network to be used in this module.
      */
     explicit Module(Network network);
 
     /**
-     * Sets a new neural network for the module.
+     * Sets a new neural network for the module, which is trained with the optimizer of the module.
      * @param newNetwork The new neural network to be set.
      */
     void setNetwork(Network newNetwork);
 
+    /**
+     * Provides read-only access to the network, which is replaced by `setNetwork` and `load`.
+     * @return The network of the module.
+     */
+    [[nodiscard]] const Network &getNetwork() const;
+
     /**
      * Retrieves the weights of the neural network.
      * @return A vector of weight vectors for each layer in the network.
@@ -92,17 +286,108 @@ public:
      */
     [[nodiscard]] vvd_t getBiases() const;
 
+    /**
+     * Provides direct access to the weights of a layer, without copying them.
+     * The view is invalidated when the network is replaced.
+     * @param layer The index of the layer.
+     * @return The row-major weights matrix of the layer, one row per neuron.
+     */
+    [[nodiscard]] csd_t getWeights(std::size_t layer) const;
+
+    /**
+     * Provides direct access to the biases of a layer, without copying them.
+     * The view is invalidated when the network is replaced.
+     * @param layer The index of the layer.
+     * @return The biases of the layer, one per neuron.
+     */
+    [[nodiscard]] csd_t getBiases(std::size_t layer) const;
+
+    /**
+     * Replaces the weights and biases of a layer, keeping the rest of the network.
+     * @param layer The index of the layer.
+     * @param weights Pointer to the row-major weights matrix of the layer, one row per neuron.
+     * @param biases Pointer to the biases of the layer, one per neuron.
+     */
+    void setParameters(std::size_t layer, const real_t *weights, const real_t *biases);
+
     /**
      * Sets the learning rate for the neural network.
      * @param learningRate The learning rate to be set.
      */
-    void setLearningRate(double learningRate);
+    void setLearningRate(real_t learningRate);
 
     /**
      * Gets the current learning rate of the neural network.
      * @return The current learning rate.
      */
-    [[nodiscard]] double getLearningRate() const;
+    [[nodiscard]] real_t getLearningRate() const;
+
+    /**
+     * Sets the update rule of the training, kept for the networks set later.
+     * The optimizer state is reset, training continues from the current parameters.
+     * @param newOptimizer The optimizer to be set. Default is SGD.
+     */
+    void setOptimizer(const Optimizer &newOptimizer);
+
+    /**
+     * @return The optimizer used by the training.
+     */
+    [[nodiscard]] const Optimizer &getOptimizer() const;
+
+    /**
+     * Sets the number of worker threads used for training.
+     * With more than one thread the training data is sharded between the workers.
+     * @param count The number of threads. Zero means one thread per hardware thread.
+     */
+    void setThreads(std::size_t count);
+
+    /**
+     * @return The number of worker threads used for training, zero means one per hardware thread.
+     */
+    [[nodiscard]] std::size_t getThreads() const;
+
+    /**
+     * Sets how the workers of the multi-threaded training share the network.
+     * @param mode The parallel mode to be set.
+     */
+    void setParallelMode(ParallelMode mode);
+
+    /**
+     * @return The current parallel mode.
+     */
+    [[nodiscard]] ParallelMode getParallelMode() const;
+
+    /**
+     * Sets whether the synchronous mode sums the gradients of the workers in a fixed order.
+     * A fixed order gives reproducible results, otherwise the gradients are summed as soon
+     * as each worker finishes, which avoids waiting for the slowest one before reducing.
+     * Has no effect on the Hogwild mode.
+     * @param value True for reproducible reductions. Default is true.
+     */
+    void setDeterministic(bool value);
+
+    /**
+     * @return Whether the synchronous mode reduces gradients in a fixed order.
+     */
+    [[nodiscard]] bool isDeterministic() const;
+
+    /**
+     * Sets the order in which the training rows are visited in every epoch.
+     * @param strategy The sampling strategy to be set. Default is Sequential.
+     */
+    void setSampling(Sampling strategy);
+
+    /**
+     * @return The current sampling strategy.
+     */
+    [[nodiscard]] Sampling getSampling() const;
+
+    /**
+     * Restarts the random orders of the sampling strategies from the given seed,
+     * so trainings with the same seed, data and network visit the rows in the same orders.
+     * @param seed The seed of the random generator.
+     */
+    void setSeed(std::uint32_t seed);
 
     /**
      * Sets the training input data.
@@ -112,11 +397,24 @@ public:
     void setTrainInput(const vvd_t &data);
 
     /**
-     * Retrieves the original (denormalized) training input data.
+     * Sets the training input data from stacked rows. Normalizes the rows and stores them.
+     * @param data Pointer to the rows, stored row-major.
+     * @param rows The number of rows.
+     * @param width The number of values in each row.
+     */
+    void setTrainInput(const real_t *data, std::size_t rows, std::size_t width);
+
+    /**
+     * Retrieves the original training input data, as it was set.
      * @return The original training input data.
      */
     [[nodiscard]] vvd_t getTrainInput() const;
 
+    /**
+     * @return The number of training rows.
+     */
+    [[nodiscard]] std::size_t getTrainSize() const;
+
     /**
      * Sets the training output data.
      * Normalizes the data and stores it for use in training the network.
@@ -125,7 +423,15 @@ public:
     void setTrainOutput(const vvd_t &data);
 
     /**
-     * Retrieves the original (denormalized) training output data.
+     * Sets the training output data from stacked rows. Normalizes the rows and stores them.
+     * @param data Pointer to the rows, stored row-major.
+     * @param rows The number of rows.
+     * @param width The number of values in each row.
+     */
+    void setTrainOutput(const real_t *data, std::size_t rows, std::size_t width);
+
+    /**
+     * Retrieves the original training output data, as it was set.
      * @return The original training output data.
      */
     [[nodiscard]] vvd_t getTrainOutput() const;
@@ -136,6 +442,14 @@ public:
      */
     void setTestInput(const vvd_t &data);
 
+    /**
+     * Sets the testing input data from stacked rows. Stores the rows.
+     * @param data Pointer to the rows, stored row-major.
+     * @param rows The number of rows.
+     * @param width The number of values in each row.
+     */
+    void setTestInput(const real_t *data, std::size_t rows, std::size_t width);
+
     /**
      * Retrieves the testing input data.
      * @return The original testing input data.
@@ -148,19 +462,53 @@ public:
      */
     void setTestOutput(const vvd_t &data);
 
+    /**
+     * Sets the testing output data from stacked rows. Stores the rows.
+     * @param data Pointer to the rows, stored row-major.
+     * @param rows The number of rows.
+     * @param width The number of values in each row.
+     */
+    void setTestOutput(const real_t *data, std::size_t rows, std::size_t width);
+
     /**
      * Retrieves the testing output data.
      * @return The original testing output data.
      */
     [[nodiscard]] vvd_t getTestOutput() const;
 
+    /**
+     * Trains on the given training rows only. Rows may repeat, e.g. in a bootstrap sample, and are
+     * visited in every epoch with the sampling strategy. No row is copied.
+     * Setting new training data trains on all the rows again.
+     *
+     * @param rows The indices of the training rows, at least one.
+     */
+    void setTrainRows(const std::vector<std::size_t> &rows);
+
+    /**
+     * Splits the training data for validation: tests on the given rows and trains on the others,
+     * in place of the testing sets. Both sides are index lists over the stored training rows,
+     * no row is copied. Setting new training data ends the split.
+     * `predict` and `compare` still use the testing sets.
+     *
+     * @param rows The indices of the held out training rows, at least one and not all of them.
+     */
+    void holdOut(const std::vector<std::size_t> &rows);
+
+    /**
+     * Normalizes the testing data now rather than on the first test.
+     * Copies of the module share its data, including the normalized rows, so the testing data
+     * must be normalized before copies test on different threads.
+     */
+    void normalizeTestData() const;
+
     /**
      * Trains the neural network for one epoch using the provided training data.
      * The function calculates and returns the average error over all training instances.
      *
      * @return The average training error for the epoch.
      */
-    double train();
+    real_t train();
 
     /**
       * Evaluates the neural network's performance on the testing dataset for one epoch.
@@ -169,7 +517,18 @@ public:
       *
       * @return The average testing error for the epoch.
       */
-    [[nodiscard]] double test() const;
+    [[nodiscard]] real_t test() const;
+
+    /**
+     * Trains the neural network for one epoch using mini-batches of the training data.
+     * Each batch is passed through the network at once and produces a single weights update.
+     * The last batch may be smaller if the data size is not a multiple of the batch size.
+     * Runs on multiple threads when more than one thread is set.
+     *
+     * @param batchSize The number of samples in each batch.
+     * @return The average training error for the epoch.
+     */
+    real_t trainBatches(std::size_t batchSize);
 
     /**
      * Repeatedly trains the neural network for a specified number of epochs.
@@ -177,9 +536,10 @@ public:
      * Returns a vector of average training errors for each epoch.
      *
      * @param epochs The number of epochs to train the network.
+     * @param batchSize The number of samples in each batch. Default is 1, which updates after every sample.
      * @return A vector of average training errors, one for each epoch.
      */
-    vd_t train(std::size_t epochs);
+    vd_t train(std::size_t epochs, std::size_t batchSize = 1);
 
     /**
      * Repeatedly tests the neural network for a specified number of epochs.
@@ -197,9 +557,10 @@ public:
      * The function returns a vector of pairs, each containing the average training and testing errors for an epoch.
      *
      * @param epochs The number of epochs to train and test the network.
+     * @param batchSize The number of samples in each training batch. Default is 1.
      * @return A vector of pairs of average training and testing errors for each epoch.
      */
-    [[nodiscard]] vpd_t trainAndTest(std::size_t epochs);
+    [[nodiscard]] vpd_t trainAndTest(std::size_t epochs, std::size_t batchSize = 1);
 
     /**
      * Predicts the outputs for the testing dataset.
@@ -219,6 +580,75 @@ public:
      * @return A vector of vectors containing the predicted outputs for the input data.
      */
     [[nodiscard]] vvd_t predict(const vvd_t &inputData) const;
+
+    /**
+     * Predicts the outputs for the testing dataset into a flat buffer.
+     * @param outputs The buffer resized to hold the denormalized predictions, one row per testing row, row-major.
+     */
+    void predict(vd_t &outputs) const;
+
+    /**
+     * Predicts the outputs for externally provided rows, written into a caller-provided buffer.
+     * Rows are split between the worker threads set by `setThreads`, and each worker
+     * pushes them through the network in batches. The workers and their buffers are kept
+     * between calls, so repeated predictions of at most as many rows don't allocate.
+     * Normalization process happens internally. You should provide denormalized data.
+     *
+     * @param inputs Pointer to the input rows, stored row-major.
+     * @param rows The number of input rows.
+     * @param outputs Pointer to a buffer with room for `rows` output rows, filled row-major
+     * with the denormalized predictions.
+     */
+    void predict(const real_t *inputs, std::size_t rows, real_t *outputs) const;
+
+    /**
+     * Collects the counters of the training phases, only filled in builds with NN_PROFILING.
+     * Includes the time and allocations of the worker threads, so in parallel training the
+     * phase times add up to more than the epochs wall time.
+     *
+     * @return The counters of the module merged with those of its network.
+     */
+    [[nodiscard]] Profiler getProfile() const;
+
+    /**
+     * Sets the counters of the module and its network back to zero.
+     */
+    void resetProfile();
+
+    /**
+     * Quantizes the trained network for read-only inference.
+     * The scales of the layers inputs are calibrated on the training input data.
+     *
+     * @return The quantized network, which expects normalized inputs like the network.
+     */
+    [[nodiscard]] QuantizedNetwork quantize() const;
+
+    /**
+     * Measures the accuracy lost by a quantized network on the testing dataset.
+     *
+     * @param quantized The quantized network, usually from `quantize`.
+     * @return The accuracy of both networks and the largest difference between their outputs.
+     */
+    [[nodiscard]] QuantizationReport compare(const QuantizedNetwork &quantized) const;
+
+    /**
+     * Saves the network and the normalization parameters of the training data in the binary model format.
+     * Only networks built from the built-in activation and loss functions can be saved.
+     *
+     * @param path The path of the model file.
+     * @return Whether the model was saved.
+     */
+    [[nodiscard]] bool save(const std::string &path) const;
+
+    /**
+     * Loads a network and its normalization parameters saved by `save`.
+     * The training data is dropped, the module is ready for predictions.
+     * To serve a model without copying its parameters use `ModelFile::open` instead.
+     *
+     * @param path The path of the model file.
+     * @return Whether the model was loaded. On failure the module is left unchanged.
+     */
+    bool load(const std::string &path);
 };
 
 #endif //FRUIT_CLASSIFIER_WASM_MODULE_H
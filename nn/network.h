@@ -8,13 +8,113 @@
 #include "nn.h"
 #include "hidden_layer.h"
 #include "output_layer.h"
+#include "profiler.h"
+#include "optimizer.h"
+
+#include <atomic>
+#include <mutex>
+#include <optional>
 
 class nn::Network {
+public:
+    /**
+     * Preallocated buffers used by the network while training and predicting.
+     * Buffers are sized from the layers dimensions on construction, so a training step
+     * or a prediction doesn't allocate any memory once the workspace has been warmed up.
+     * Batches grow the buffers on their first use, after that they are reused as well.
+     */
+    class Workspace {
+        friend class Network;
+
+        vvd_t errors;
+        vd_t front;
+        vd_t back;
+        vd_t actual;
+        vd_t desired;
+
+    public:
+        /**
+         * Constructs a workspace sized for the given network.
+         * A workspace can be used with any network of the same dimensions.
+         *
+         * @param network The network to size the buffers for.
+         */
+        explicit Workspace(const Network &network);
+    };
+
+    /**
+     * Accumulated gradients of the weights and biases of every layer.
+     * Shaped like the network parameters, used to sum gradients over several samples
+     * or several workers before applying them in one update.
+     */
+    class Gradients {
+        friend class Network;
+
+        vvd_t weights;
+        vvd_t biases;
+
+    public:
+        /**
+         * Constructs zeroed gradients shaped for the given network.
+         *
+         * @param network The network to shape the gradients for.
+         */
+        explicit Gradients(const Network &network);
+
+        /**
+         * Resets all gradients to zero.
+         */
+        void clear();
+
+        /**
+         * Adds other gradients of the same shape to these ones.
+         *
+         * @param other The gradients to be added.
+         */
+        Gradients &operator+=(const Gradients &other);
+    };
+
 private:
     const std::size_t size;
     vl_t layers;
     OutputLayer outputLayer;
     loss::function_t lossFunction;
+    Workspace workspace;
+    Profiler profiler;
+    Optimizer optimizer;
+
+    /**
+     * Number of updates applied with the current optimizer, counted atomically as Hogwild workers
+     * apply their updates to the same network at once.
+     */
+    std::atomic<std::size_t> steps{0};
+
+    /**
+     * Gradients of the batches trained with an optimizer other than SGD, which needs them whole before updating.
+     */
+    std::optional<Gradients> batchGradients;
+
+    /**
+     * @param actual The stacked outputs of the network.
+     * @param desired The stacked desired outputs.
+     * @return The sum of the errors calculated by the lossFunction for each row.
+     */
+    real_t batchLoss(const vd_t &actual, const vd_t &desired);
+
+    /**
+     * Propagates the gradients cashed by the output layer back through the hidden layers.
+     */
+    void propagateHiddenGradients();
+
+    /**
+     * Forward and backward propagates a batch, leaving the gradients cashed in every layer.
+     * With cross-entropy and a softmax output, the output layer uses the fused kernel.
+     *
+     * @param inputs Matrix of given input values, one sample per row.
+     * @param outputs Matrix of expected output values, one sample per row.
+     * @return The sum of the errors calculated by the lossFunction for each sample.
+     */
+    real_t propagate(const vd_t &inputs, const vd_t &outputs);
 
 public:
     /**
@@ -28,11 +128,46 @@ public:
      */
     explicit Network(vl_t hiddenLayers, OutputLayer outputLayer, loss::function_t lossFunction);
 
+    Network(const Network &other);
+
+    Network(Network &&other) noexcept;
+
     /**
      * @return The number of layers in the network, including the output layer.
      */
     [[nodiscard]] std::size_t getSize() const;
 
+    /**
+     * @return The loss function used in backpropagation.
+     */
+    [[nodiscard]] loss::function_t getLossFunction() const;
+
+    /**
+     * Sets the update rule used by `train`, `trainBatch` and `apply` with a sample count.
+     * The optimizer state of every layer is reset, even if the optimizer is the same.
+     *
+     * @param newOptimizer The optimizer to be used. Default is SGD.
+     */
+    void setOptimizer(const Optimizer &newOptimizer);
+
+    /**
+     * @return The optimizer used for the updates.
+     */
+    [[nodiscard]] const Optimizer &getOptimizer() const;
+
+    /**
+     * Counters of the training steps of this network, see Profiler.
+     * `apply` isn't counted here, callers applying accumulated gradients count it themselves.
+     *
+     * @return The counters of the network.
+     */
+    [[nodiscard]] const Profiler &getProfiler() const;
+
+    /**
+     * @return The counters of the network, to be merged or reset.
+     */
+    Profiler &getProfiler();
+
     /**
      * Provides access to a specific layer in the network.
      *
@@ -70,9 +205,9 @@ public:
      * All layers are activated and all their outputs are cashed.
      *
      * @param input Vector of input values.
-     * @return The calculated output values.
+     * @return A reference to the calculated output values, cashed by the output layer.
      */
-    vd_t forwardPropagate(const vd_t &input);
+    const vd_t &forwardPropagate(const vd_t &input);
 
     /**
      * Backward-propagates the inputs vector through the network.
@@ -91,7 +226,79 @@ public:
      * @param alpha Learning rate
      * @return The outputs error calculated by the lossFunction.
      */
-    double train(const vd_t &input, const vd_t &output, double alpha);
+    real_t train(const vd_t &input, const vd_t &output, real_t alpha);
+
+    /**
+     * Trains the neural network on a mini-batch of input-output pairs.
+     * Samples are stacked as rows of row-major matrices, the whole batch is propagated
+     * through each layer as a matrix product. Gradients are averaged over the batch
+     * and a single update is applied to the weights with the optimizer of the network.
+     *
+     * @param inputs Matrix of given input values, one sample per row.
+     * @param outputs Matrix of expected output values, one sample per row.
+     * @param alpha Learning rate
+     * @return The sum of the errors calculated by the lossFunction for each sample.
+     */
+    real_t trainBatch(const vd_t &inputs, const vd_t &outputs, real_t alpha);
+
+    /**
+     * Propagates a batch of input-output pairs through the network and adds the resulting
+     * gradients to the given accumulator, without updating the weights.
+     *
+     * @param inputs Matrix of given input values, one sample per row.
+     * @param outputs Matrix of expected output values, one sample per row.
+     * @param gradients The accumulator the gradients are added to.
+     * @return The sum of the errors calculated by the lossFunction for each sample.
+     */
+    real_t accumulate(const vd_t &inputs, const vd_t &outputs, Gradients &gradients);
+
+    /**
+     * Applies accumulated gradients to all layers: w -= rate * gradient.
+     *
+     * @param gradients The accumulated gradients.
+     * @param rate The scale applied to the gradients, usually the learning rate divided by the number of samples.
+     */
+    void apply(const Gradients &gradients, real_t rate);
+
+    /**
+     * Applies gradients summed over a number of samples with the optimizer of the network.
+     * The parameters of every layer are updated from the average gradient.
+     * Each update gets its own step of the bias correction, even when several threads apply at once.
+     *
+     * @param gradients The accumulated gradients.
+     * @param alpha Learning rate
+     * @param samples The number of samples the gradients were summed over.
+     */
+    void apply(const Gradients &gradients, real_t alpha, std::size_t samples);
+
+    /**
+     * Applies gradients like `apply`, holding the lock of every layer while the layer is updated,
+     * so the weights and the optimizer state of a layer always change together.
+     * Lets several threads update the same network, as in Hogwild training.
+     *
+     * @param gradients The accumulated gradients.
+     * @param alpha Learning rate
+     * @param samples The number of samples the gradients were summed over.
+     * @param locks One mutex per layer, also held by `setParameters` when reading the network.
+     */
+    void apply(const Gradients &gradients, real_t alpha, std::size_t samples, std::vector<std::mutex> &locks);
+
+    /**
+     * Copies the weights and biases of a network with the same dimensions.
+     * No allocation happens, caches and workspace are left untouched.
+     *
+     * @param other The network to copy the parameters from.
+     */
+    void setParameters(const Network &other);
+
+    /**
+     * Copies the parameters like `setParameters`, holding the lock of every layer of the other
+     * network while the layer is copied, so the copy never sees a layer half updated.
+     *
+     * @param other The network to copy the parameters from.
+     * @param locks One mutex per layer of the other network, the ones given to its `apply`.
+     */
+    void setParameters(const Network &other, std::vector<std::mutex> &locks);
 
     /**
      * Tests the neural network on a given input-output pair.
@@ -101,7 +308,7 @@ public:
      * @param output Vector of expected output values
      * @return The outputs error calculated by the lossFunction.
      */
-    [[nodiscard]] double test(const vd_t &input, const vd_t &output) const;
+    [[nodiscard]] real_t test(const vd_t &input, const vd_t &output) const;
 
     /**
      * Makes predictions based on input data.
@@ -110,6 +317,16 @@ public:
      * @return Predicted output vector.
      */
     [[nodiscard]] vd_t predict(const vd_t &input) const;
+
+    /**
+     * Makes predictions based on input data without allocating memory.
+     * Several threads can predict at once as long as each uses its own workspace.
+     *
+     * @param input Vector of input values.
+     * @param workspace The workspace to hold the intermediate results.
+     * @return A reference to the predicted output vector, stored in the given workspace.
+     */
+    const vd_t &predict(const vd_t &input, Workspace &workspace) const;
 };
 
 #endif //FRUIT_CLASSIFIER_WASM_NETWORK_H
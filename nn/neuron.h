@@ -9,7 +9,7 @@
 
 class nn::Neuron : public vd_t {
 private:
-    double bias;
+    real_t bias;
 
 public:
     /**
@@ -18,14 +18,14 @@ public:
      * @param weights Vector of initial weights.
      * @param threshold Initial bias for the neuron.
      */
-    explicit Neuron(vd_t weights, double threshold);
+    explicit Neuron(vd_t weights, real_t threshold);
 
     /**
      * Getter for the bias of the neuron.
      *
      * @return The current bias of the neuron.
      */
-    [[nodiscard]] double getBias() const;
+    [[nodiscard]] real_t getBias() const;
 
     /**
      * Adjusts the weights and bias of the neuron.
@@ -33,7 +33,7 @@ public:
      * @param weightDeltas Vector of changes to be applied to each weight.
      * @param biasDelta Change applied to the bias.
      */
-    void adjust(const vd_t &weightDeltas, double biasDelta);
+    void adjust(const vd_t &weightDeltas, real_t biasDelta);
 
     /**
      * Uses the gradient and learning rate to calculate all the deltas.
@@ -46,7 +46,7 @@ public:
      * @param gradient Gradient error value
      * @param alpha Learning rate
      */
-    void adjust(const vd_t &inputs, double gradient, double alpha);
+    void adjust(const vd_t &inputs, real_t gradient, real_t alpha);
 
     /**
      * Calculates the weighted sum of inputs and the bias.
@@ -55,7 +55,7 @@ public:
      * @param inputs Vector of input values.
      * @return The weighted sum.
      */
-    [[nodiscard]] double process(const vd_t &inputs) const;
+    [[nodiscard]] real_t process(const vd_t &inputs) const;
 };
 
 #endif //FRUIT_CLASSIFIER_WASM_NEURON_H
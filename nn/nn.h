@@ -5,6 +5,8 @@
 #ifndef FRUIT_CLASSIFIER_WASM_NN_H
 #define FRUIT_CLASSIFIER_WASM_NN_H
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 /**
@@ -43,6 +45,12 @@ namespace nn {
      */
     class Network;
 
+    /**
+     * Update rule of the training: plain SGD, SGD with momentum or Nesterov momentum, RMSProp or Adam.
+     * The per-parameter state is kept by the layers next to their weights.
+     */
+    class Optimizer;
+
     /**
      * The Module class encapsulates a neural network and
      * manages its training, testing, and regularization processes.
@@ -50,6 +58,75 @@ namespace nn {
      */
     class Module;
 
+    /**
+     * Hyperparameter search that trains many configurations of a network at once, one per worker thread.
+     * All the trained modules share one copy of the training and testing data.
+     */
+    class Sweep;
+
+    /**
+     * K-fold cross-validation of a module, training the folds in parallel.
+     * Folds are index lists over the training rows of the module, no row is copied.
+     */
+    class CrossValidation;
+
+    /**
+     * A fixed set of worker threads that run the same task in parallel.
+     * Used by the parallel training and inference paths.
+     */
+    class ThreadPool;
+
+    /**
+     * Non-owning view over a contiguous range of values.
+     * Used to expose rows of the layers' weight matrices without copying them.
+     */
+    template<typename T>
+    class Span;
+
+    /**
+     * A network with dimensions and hidden activation fixed at compile time.
+     * Parameters live in std::array members, so tiny models predict without any heap traffic.
+     * Used for inference only, it converts from and to the dynamic Network.
+     */
+    template<typename Activation, std::size_t... Dimensions>
+    class BasicStaticNetwork;
+
+    /**
+     * Read-only copy of a trained network with int8 weights and int32 accumulation.
+     * Takes an eighth of the memory of double weights, used for high-volume inference.
+     */
+    class QuantizedNetwork;
+
+    /**
+     * Bagged ensemble of networks with the same dimensions, trained in parallel on bootstrap samples.
+     * Predicts with all the members in one pass over their stacked weights, averaging or voting.
+     */
+    class Ensemble;
+
+    /**
+     * A network and its normalization parameters stored in a versioned, aligned binary file.
+     * Files are memory-mapped on load, so inference can run straight from the mapped pages.
+     */
+    class ModelFile;
+
+    /**
+     * Streaming CSV reader that detects headers and encodes categorical columns into numbers.
+     * Fitted on the training data, then used to encode the testing data the same way.
+     */
+    class CsvCodec;
+
+    /**
+     * Rows of samples stored in one contiguous row-major buffer, with their min-max parameters.
+     * Keeps the normalized rows cached until the rows or the parameters change.
+     */
+    class Dataset;
+
+    /**
+     * Time, sample and allocation counters of the training phases.
+     * Only collected in builds with NN_PROFILING, otherwise the instrumentation compiles to nothing.
+     */
+    class Profiler;
+
     /*
      * Activation Functions Namespace
      */
@@ -66,16 +143,27 @@ namespace nn {
      * Different types used frequently in nn namespace
      */
     inline namespace type {
+        /**
+         * The scalar type used for all computations.
+         * It's `double` by default, define `NN_FLOAT32` to compute in single precision.
+         */
+#ifdef NN_FLOAT32
+        using real_t = float;
+#else
+        using real_t = double;
+#endif
         using ui_t = unsigned short int;
         using vi_t = std::vector<ui_t>;
-        using vd_t = std::vector<double>;
+        using vd_t = std::vector<real_t>;
         using vn_t = std::vector<Neuron>;
         using vl_t = std::vector<HiddenLayer>;
         using vf_t = std::vector<act::Function>;
-        using fdd_t = double (*)(double);
-        using vpd_t = std::vector<std::pair<double, double>>;
-        using vvd_t = std::vector<std::vector<double>>;
+        using fdd_t = real_t (*)(real_t);
+        using vpd_t = std::vector<std::pair<real_t, real_t>>;
+        using vvd_t = std::vector<vd_t>;
         using vvvd_t = std::vector<vvd_t>;
+        using sd_t = Span<real_t>;
+        using csd_t = Span<const real_t>;
     }
 
     namespace act {
@@ -92,6 +180,59 @@ namespace nn {
             fdd_t der;
         };
 
+        /**
+         * Activation function and derivative applied to a whole span of values at once.
+         * Whole-span calls avoid a function pointer call per element and let the loops vectorize.
+         */
+        struct Kernel {
+            /**
+             * Applies the activation function: y[i] = f(x[i]). x and y may be the same pointer.
+             */
+            void (*fun)(const real_t *x, real_t *y, std::size_t n);
+            /**
+             * Multiplies gradients by the derivative: out[i] = g[i] * f'(y[i]),
+             * where y holds the activated outputs. out may be the same pointer as g.
+             */
+            void (*der)(const real_t *y, const real_t *g, real_t *out, std::size_t n);
+        };
+
+        /**
+         * Accuracy tiers of the activation kernels.
+         */
+        enum class Accuracy {
+            /**
+             * Uses the standard library transcendental functions.
+             */
+            Exact,
+            /**
+             * Uses fast polynomial approximations of exp, sigmoid and tanh.
+             * The error of sigmoid and tanh stays below 1e-8 in double precision and 1e-6 in single precision,
+             * good enough for training. Inputs must be finite.
+             */
+            Fast
+        };
+
+        /**
+         * Sets the accuracy tier used by the kernels of all layers. Default is Exact.
+         * Should not be changed while a network is being trained or used on another thread.
+         *
+         * @param accuracy The accuracy tier to be used.
+         */
+        void setAccuracy(Accuracy accuracy);
+
+        /**
+         * @return The accuracy tier used by the kernels.
+         */
+        Accuracy getAccuracy();
+
+        /**
+         * Finds the whole-span kernel of a built-in activation function for the current accuracy tier.
+         *
+         * @param function The activation function.
+         * @return A pointer to the kernel, or nullptr for custom functions without a kernel.
+         */
+        const Kernel *kernel(const Function &function);
+
         extern Function step;
         extern Function sign;
         extern Function linear;
@@ -99,6 +240,15 @@ namespace nn {
         extern Function sigmoid;
         extern Function tanh;
 
+        /**
+         * Compile-time counterparts of the built-in activation functions, used as template arguments.
+         * Each provides static inline `fun` and a `function()` returning the matching Function.
+         */
+        struct Linear;
+        struct Relu;
+        struct Sigmoid;
+        struct Tanh;
+
         /**
          * Special activation function used for output layers
          * The softmax function converts a vector of real values into a probability distribution.
@@ -107,8 +257,24 @@ namespace nn {
          * @return Vector of all output values
          */
         vd_t softmax(const vd_t &t);
+
+        /**
+         * Applies the softmax function in place.
+         * The maximum value is subtracted first (log-sum-exp), so large values don't overflow.
+         *
+         * @param values Pointer to the values to be converted into a probability distribution.
+         * @param n Number of values.
+         */
+        void softmax(real_t *values, std::size_t n);
     }
 
+    /**
+     * Static network with tanh hidden layers, the default activation of the web interface.
+     * For example StaticNetwork<4, 3, 4> takes 4 inputs through a 3-neuron hidden layer to 4 outputs.
+     */
+    template<std::size_t... Dimensions>
+    using StaticNetwork = BasicStaticNetwork<act::Tanh, Dimensions...>;
+
     /**
      * Loss Functions Namespace
      */
@@ -116,7 +282,7 @@ namespace nn {
         /**
          * The general type for a loss function.
          */
-        using function_t = double (*)(const vd_t &, const vd_t &);
+        using function_t = real_t (*)(const vd_t &, const vd_t &);
 
         /**
          * Calculates the Sum Square Error.
@@ -124,7 +290,32 @@ namespace nn {
          * @param actual Actual output values
          * @return The Sum Square Error
          */
-        double sse(const vd_t &desired, const vd_t &actual);
+        real_t sse(const vd_t &desired, const vd_t &actual);
+
+        /**
+         * Calculates the Cross-Entropy of probability distributions.
+         * For a single output it's the binary cross-entropy of a sigmoid output.
+         * Pairs with the output layer, whose gradient (actual - desired) is the exact gradient
+         * of this loss with respect to the softmax or sigmoid inputs.
+         *
+         * @param desired Desired output values, one-hot coded
+         * @param actual Actual output values
+         * @return The Cross-Entropy
+         */
+        real_t crossEntropy(const vd_t &desired, const vd_t &actual);
+
+        /**
+         * Fused softmax and cross-entropy over one row of output layer values, computed in one pass.
+         * Converts the values into probabilities in place, and writes the gradient of the loss
+         * with respect to the values. Uses one exp per value and one log per row.
+         *
+         * @param values Pointer to the values before activation, replaced by the probabilities.
+         * @param desired Pointer to the desired output values.
+         * @param gradients Pointer to the buffer receiving the gradients (probabilities - desired).
+         * @param n Number of values.
+         * @return The Cross-Entropy of the row.
+         */
+        real_t softmaxCrossEntropy(real_t *values, const real_t *desired, real_t *gradients, std::size_t n);
 
         /**
          * Calculates the Mean Square Error.
@@ -132,7 +323,7 @@ namespace nn {
          * @param actual Actual output values
          * @return The Mean Square Error
          */
-        double mse(const vd_t &desired, const vd_t &actual);
+        real_t mse(const vd_t &desired, const vd_t &actual);
     }
 
     /**
@@ -143,7 +334,7 @@ namespace nn {
         /**
          * The general type for regularization functions.
          */
-        using regularizer_t = double (*)(const vd_t &, double);
+        using regularizer_t = real_t (*)(const vd_t &, real_t);
 
         /**
          * L1 Regularization.
@@ -152,7 +343,7 @@ namespace nn {
          * @param lambda Regularization coefficient
          * @return The L1 regularization term
          */
-        double l1(const vd_t &weights, double lambda);
+        real_t l1(const vd_t &weights, real_t lambda);
 
         /**
          * L2 Regularization.
@@ -161,7 +352,7 @@ namespace nn {
          * @param lambda Regularization coefficient
          * @return The L2 regularization term
          */
-        double l2(const vd_t &weights, double lambda);
+        real_t l2(const vd_t &weights, real_t lambda);
 
         /**
          * Min-Max Normalization.
@@ -172,6 +363,15 @@ namespace nn {
          */
         vd_t minmax(const vd_t &data, const vpd_t& minMaxParams);
 
+        /**
+         * Min-Max Normalization of stacked rows, written into the given output.
+         * @param data Pointer to the rows of data points, stored row-major.
+         * @param out Pointer to the normalized rows. May be the same as data.
+         * @param n Total number of values, a multiple of the number of parameters.
+         * @param minMaxParams parameters used in normalization process, one per column.
+         */
+        void minmax(const real_t *data, real_t *out, std::size_t n, const vpd_t &minMaxParams);
+
         /**
          * Inverse Min-Max Normalization (De-normalization).
          * Reverts the normalized data back to its original scale.
@@ -180,12 +380,87 @@ namespace nn {
          * @return Denormalized data vector
          */
         vd_t inverseMinmax(const vd_t &data, const vpd_t& minMaxParams);
+
+        /**
+         * Inverse Min-Max Normalization of stacked rows, written into the given output.
+         * @param data Pointer to the rows of normalized data points, stored row-major.
+         * @param out Pointer to the denormalized rows. May be the same as data.
+         * @param n Total number of values, a multiple of the number of parameters.
+         * @param minMaxParams parameters used in de-normalization process, one per column.
+         */
+        void inverseMinmax(const real_t *data, real_t *out, std::size_t n, const vpd_t &minMaxParams);
+    }
+
+    /**
+     * Compute Kernels Namespace.
+     * Vectorized building blocks used by neurons and layers in their innermost loops.
+     * The instruction set is selected at build time: AVX2 or SSE2 on native builds,
+     * SIMD128 on WebAssembly builds compiled with `-msimd128`, and a scalar fallback otherwise.
+     * Define `NN_SCALAR_KERNELS` to force the scalar fallback.
+     */
+    namespace kernel {
+        /**
+         * @return The name of the instruction set the kernels run with.
+         */
+        const char *name();
+
+        /**
+         * Calculates the dot product of two vectors.
+         * @param a Pointer to the first vector.
+         * @param b Pointer to the second vector.
+         * @param n Number of values in each vector.
+         * @return The sum of the products of the values.
+         */
+        real_t dot(const real_t *a, const real_t *b, std::size_t n);
+
+        /**
+         * Adds a scaled vector to another vector in place: y += alpha * x.
+         * @param alpha The scale factor.
+         * @param x Pointer to the scaled vector.
+         * @param y Pointer to the vector to be updated.
+         * @param n Number of values in each vector.
+         */
+        void axpy(real_t alpha, const real_t *x, real_t *y, std::size_t n);
     }
 
     /**
      * The Factory Namespace
      */
     namespace make {
+        /**
+         * Initialization schemes of the weights and biases of new layers.
+         */
+        enum class Init {
+            /**
+             * Weights and biases drawn uniformly in [-numNeurons / 2.4, +numNeurons / 2.4].
+             * The original scheme, its range grows with the width of the layer.
+             */
+            Range,
+            /**
+             * Xavier/Glorot: weights drawn uniformly in +-sqrt(6 / (numInputs + numNeurons)), zero biases.
+             * Keeps the variance of the outputs of tanh, sigmoid and linear layers close to that of their inputs.
+             */
+            Xavier,
+            /**
+             * He: weights drawn uniformly in +-sqrt(6 / numInputs), zero biases.
+             * Makes up for the half of the inputs relu sets to zero.
+             */
+            He,
+            /**
+             * He for relu layers, Xavier for the other hidden layers and the output layer.
+             */
+            Auto
+        };
+
+        /**
+         * Reseeds the random generator of the calling thread, used by all the functions of this namespace.
+         * Every thread draws from its own generator, seeded from std::random_device until this is called,
+         * so threads can build networks at the same time and each thread's networks are reproducible.
+         *
+         * @param value The seed of the generator.
+         */
+        void seed(std::uint32_t value);
+
         /**
          * Creates a Neuron with the specified options.
          * Weights and bias are given random values between the given boundaries.
@@ -196,7 +471,7 @@ namespace nn {
          * @param highBound Upper bound for random weight initialization.
          * @return A Neuron object configured as per the provided options.
          */
-        Neuron neuron(const ui_t &numInputs, double lowBound, double highBound);
+        Neuron neuron(const ui_t &numInputs, real_t lowBound, real_t highBound);
 
         /**
          * Creates a vector of neurons with the specified options
@@ -210,7 +485,18 @@ namespace nn {
          * @param rangeFactor Random values range factor. Default is 2.4.
          * @return A vector of properly configured neurons.
          */
-        vn_t layer(const ui_t &numInputs, const ui_t &numNeurons, double rangeFactor = 2.4);
+        vn_t layer(const ui_t &numInputs, const ui_t &numNeurons, real_t rangeFactor = 2.4);
+
+        /**
+         * Creates a vector of neurons initialized with the given scheme.
+         *
+         * @param numInputs Number of inputs for the neurons.
+         * @param numNeurons Number of neurons for the layer.
+         * @param init The initialization scheme.
+         * @param function The activation function of the layer, picks the scheme of Init::Auto.
+         * @return A vector of properly configured neurons.
+         */
+        vn_t layer(const ui_t &numInputs, const ui_t &numNeurons, Init init, const act::Function &function);
 
         /**
          * Creates a Network with the specified options.
@@ -223,9 +509,11 @@ namespace nn {
          * @param functions Activation functions used for each hidden layer in the neural network.
          * For N dimensions there should be N - 2 functions.
          * @param lossFunction Loss function used for backward propagation and error calculation.
+         * @param init The initialization scheme of all the layers. Default is Auto.
          * @return A Network object configured as per the provided options.
          */
-        Network network(const vi_t &dimensions, const vf_t &functions, loss::function_t lossFunction);
+        Network network(const vi_t &dimensions, const vf_t &functions, loss::function_t lossFunction,
+                        Init init = Init::Auto);
 
         /**
          * Creates a Network with the specified options.
@@ -237,9 +525,11 @@ namespace nn {
          * Last value represents the number of neurons for the output layer.
          * @param function Activation function used for all hidden layers in the network.
          * @param lossFunction Loss function used for backward propagation and error calculation.
+         * @param init The initialization scheme of all the layers. Default is Auto.
          * @return A Network object configured as per the provided options.
          */
-        Network network(const vi_t &dimensions, const act::Function &functions, loss::function_t lossFunction);
+        Network network(const vi_t &dimensions, const act::Function &functions, loss::function_t lossFunction,
+                        Init init = Init::Auto);
     }
 }
 
@@ -0,0 +1,102 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#ifndef FRUIT_CLASSIFIER_WASM_OPTIMIZER_H
+#define FRUIT_CLASSIFIER_WASM_OPTIMIZER_H
+
+#include "nn.h"
+
+/**
+ * The optimizer only holds the method and its hyperparameters. The state of every parameter
+ * lives in the layers, in arrays shaped like their weights and biases, and is updated together
+ * with the parameter in one pass over the arrays.
+ *
+ * Updates use the average gradient g of a batch and the learning rate a:
+ * - SGD: w -= a * g
+ * - Momentum: v = momentum * v + g, w -= a * v
+ * - Nesterov: v = momentum * v + g, w -= a * (g + momentum * v)
+ * - RMSProp: s = decay * s + (1 - decay) * g^2, w -= a * g / (sqrt(s) + epsilon)
+ * - Adam: m = beta1 * m + (1 - beta1) * g, s = beta2 * s + (1 - beta2) * g^2,
+ *   w -= a * m / (1 - beta1^t) / (sqrt(s / (1 - beta2^t)) + epsilon), t being the number of updates.
+ */
+class nn::Optimizer {
+public:
+    enum class Method {
+        SGD,
+        Momentum,
+        Nesterov,
+        RMSProp,
+        Adam
+    };
+
+private:
+    Method method;
+    real_t beta1;
+    real_t beta2;
+    real_t epsilon;
+
+public:
+    /**
+     * Constructs an optimizer, prefer the factory functions which set the usual hyperparameters.
+     *
+     * @param method The update rule.
+     * @param beta1 Decay of the first moments: the momentum, or Adam's beta1.
+     * @param beta2 Decay of the second moments: RMSProp's decay, or Adam's beta2.
+     * @param epsilon Added to the root of the second moments to avoid dividing by zero.
+     */
+    explicit Optimizer(Method method = Method::SGD, real_t beta1 = 0.9, real_t beta2 = 0.999, real_t epsilon = 1e-8);
+
+    /**
+     * @return Plain gradient descent, the default.
+     */
+    static Optimizer sgd();
+
+    /**
+     * @param momentum The fraction of the previous step kept in the next one.
+     * @param nesterov Whether to apply the momentum to the look-ahead gradient.
+     */
+    static Optimizer momentum(real_t momentum = 0.9, bool nesterov = false);
+
+    /**
+     * @param decay The decay of the average of the squared gradients.
+     * @param epsilon Added to the root of the average to avoid dividing by zero.
+     */
+    static Optimizer rmsprop(real_t decay = 0.9, real_t epsilon = 1e-8);
+
+    /**
+     * @param beta1 The decay of the average of the gradients.
+     * @param beta2 The decay of the average of the squared gradients.
+     * @param epsilon Added to the root of the average to avoid dividing by zero.
+     */
+    static Optimizer adam(real_t beta1 = 0.9, real_t beta2 = 0.999, real_t epsilon = 1e-8);
+
+    [[nodiscard]] Method getMethod() const;
+
+    /**
+     * @return Whether a first moment is kept for every parameter, by Momentum, Nesterov and Adam.
+     */
+    [[nodiscard]] bool hasFirstMoments() const;
+
+    /**
+     * @return Whether a second moment is kept for every parameter, by RMSProp and Adam.
+     */
+    [[nodiscard]] bool hasSecondMoments() const;
+
+    /**
+     * Updates parameters and their state in a single pass.
+     *
+     * @param parameters Pointer to the parameters to be updated.
+     * @param gradients Pointer to the gradients of the parameters.
+     * @param first Pointer to the first moments, unused by SGD and RMSProp.
+     * @param second Pointer to the second moments, unused by SGD, Momentum and Nesterov.
+     * @param n Number of parameters.
+     * @param rate The learning rate.
+     * @param scale Multiplies the gradients, e.g. one over the batch size for summed gradients.
+     * @param step The number of updates including this one, starting at 1. Used for Adam's bias correction.
+     */
+    void update(real_t *parameters, const real_t *gradients, real_t *first, real_t *second, std::size_t n,
+                real_t rate, real_t scale, std::size_t step) const;
+};
+
+#endif //FRUIT_CLASSIFIER_WASM_OPTIMIZER_H
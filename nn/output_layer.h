@@ -14,11 +14,26 @@ public:
      *
      * @param neurons The neurons of the layer.
      */
-    explicit OutputLayer(vn_t neurons);
+    explicit OutputLayer(const vn_t &neurons);
 
-    [[nodiscard]] vd_t activate(const vd_t &inputs) const override;
+    using Layer::activate;
+    using Layer::calculateGradients;
 
-    [[nodiscard]] vd_t calculateGradients(const vd_t &intermediateGradients) const override;
+    void activate(const vd_t &inputs, vd_t &outputs) const override;
+
+    void calculateGradients(const vd_t &intermediateGradients, vd_t &gradients) const override;
+
+    /**
+     * Activates the layer and calculates its gradients against the desired outputs in one pass,
+     * using the fused `loss::softmaxCrossEntropy` kernel on every row.
+     * Outputs and gradients are cashed, like `activateAndCache` followed by `calculateGradientsAndCash`.
+     * Only meaningful for a softmax layer, so the layer must have more than one neuron.
+     *
+     * @param inputs A vector of input values to the layer.
+     * @param desired The desired output values, one-hot coded.
+     * @return The sum of the cross-entropy of every row.
+     */
+    real_t activateWithCrossEntropy(const vd_t &inputs, const vd_t &desired);
 };
 
 #endif //FRUIT_CLASSIFIER_WASM_OUTPUT_LAYER_H
@@ -0,0 +1,149 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#ifndef FRUIT_CLASSIFIER_WASM_PROFILER_H
+#define FRUIT_CLASSIFIER_WASM_PROFILER_H
+
+#include "nn.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * Counters are plain values owned by each network and module, so recording never synchronizes.
+ * Worker threads record into their own replica of the network, which the module merges afterwards.
+ *
+ * Allocations are counted by the global operator new of nn/alloc/counting_new.cpp, which only the executables
+ * linking the nn_alloc_counter object library get, and attributed to the phase running on the allocating thread.
+ * Other executables keep their allocator and report no allocations.
+ */
+class nn::Profiler {
+public:
+    enum class Phase {
+        /**
+         * Activating the layers while training.
+         */
+        Forward,
+        /**
+         * Computing the errors of the outputs, fused with the output activation and gradients for cross-entropy.
+         */
+        Loss,
+        /**
+         * Propagating the gradients back through the hidden layers.
+         */
+        Backward,
+        /**
+         * Adjusting or accumulating the weights, and applying accumulated gradients.
+         */
+        Update,
+        /**
+         * Normalizing the training data when it's set.
+         */
+        Normalization,
+        /**
+         * Normalizing the testing data, on the first testing epoch after the data or the training data changes.
+         */
+        TestNormalization,
+        /**
+         * Wall time of the training epochs, used for the throughput.
+         */
+        Epoch
+    };
+
+    static constexpr std::size_t phases = 7;
+
+#ifdef NN_PROFILING
+    static constexpr bool enabled = true;
+#else
+    static constexpr bool enabled = false;
+#endif
+
+    /**
+     * Records the time and allocations of a phase from construction to destruction.
+     */
+    class Scope {
+#ifdef NN_PROFILING
+        Profiler &profiler;
+        Phase phase;
+        std::chrono::steady_clock::time_point start;
+        std::uint64_t allocations;
+
+    public:
+        Scope(Profiler &profiler, Phase phase);
+
+        ~Scope();
+#else
+    public:
+        Scope(Profiler &, Phase) {}
+#endif
+
+        Scope(const Scope &) = delete;
+
+        Scope &operator=(const Scope &) = delete;
+    };
+
+private:
+#ifdef NN_PROFILING
+    std::array<std::uint64_t, phases> nanoseconds{};
+    std::array<std::uint64_t, phases> allocations{};
+    std::uint64_t samples = 0;
+#endif
+
+public:
+    /**
+     * Counts samples pushed through the network while training.
+     * @param n The number of samples.
+     */
+#ifdef NN_PROFILING
+    void addSamples(std::size_t n) { samples += n; }
+#else
+    void addSamples(std::size_t) {}
+#endif
+
+    /**
+     * Sets every counter back to zero.
+     */
+    void reset();
+
+    /**
+     * Adds the counters of another profiler, e.g. of a worker replica.
+     */
+    Profiler &operator+=(const Profiler &other);
+
+    /**
+     * @return The time spent in the phase, zero when profiling is disabled.
+     */
+    [[nodiscard]] real_t getSeconds(Phase phase) const;
+
+    /**
+     * @return The number of allocations made during the phase, zero when profiling is disabled.
+     */
+    [[nodiscard]] std::size_t getAllocations(Phase phase) const;
+
+    /**
+     * @return The number of samples trained on.
+     */
+    [[nodiscard]] std::size_t getSamples() const;
+
+    /**
+     * @return The training throughput over the epochs wall time, or over the time of the training
+     * phases when no epoch was timed, e.g. when a network is trained directly. Zero without samples.
+     */
+    [[nodiscard]] real_t getSamplesPerSecond() const;
+
+    /**
+     * @return The number of allocations made on the calling thread since it started,
+     * always zero when profiling is disabled.
+     */
+    [[nodiscard]] static std::uint64_t threadAllocations();
+
+    /**
+     * Counts an allocation on the calling thread, called by the counting operator new.
+     * Does nothing when profiling is disabled.
+     */
+    static void countAllocation();
+};
+
+#endif //FRUIT_CLASSIFIER_WASM_PROFILER_H
@@ -0,0 +1,89 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#ifndef FRUIT_CLASSIFIER_WASM_QUANTIZED_NETWORK_H
+#define FRUIT_CLASSIFIER_WASM_QUANTIZED_NETWORK_H
+
+#include "nn.h"
+#include "network.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Weights and layer inputs are quantized symmetrically: q = round(x / scale), clamped to [-127, 127].
+ * Each layer has one scale for its inputs, calibrated on sample data run through the original network,
+ * and one scale for the weights of each neuron, taken from their largest magnitude.
+ * Products are accumulated in int32 and scaled back to real values before adding the biases,
+ * which are kept at full precision, and applying the activation functions.
+ */
+class nn::QuantizedNetwork {
+private:
+    /**
+     * A quantized layer, weights are stored row-major like Layer.
+     */
+    struct Dense {
+        std::size_t inputs;
+        std::vector<std::int8_t> weights;
+        vd_t biases;
+        vd_t weightScales;
+        real_t inputScale;
+        act::Function function;
+    };
+
+    std::vector<Dense> layers;
+
+    /**
+     * Activates one layer for stacked rows of inputs.
+     *
+     * @param layer The layer to be activated.
+     * @param inputs The stacked inputs of the layer.
+     * @param outputs The stacked outputs, resized to fit.
+     * @param quantized Buffer for the quantized inputs.
+     * @param last Whether the layer is the output layer.
+     */
+    static void activate(const Dense &layer, const vd_t &inputs, vd_t &outputs,
+                         std::vector<std::int8_t> &quantized, bool last);
+
+public:
+    /**
+     * Quantizes a trained network. The scales of the layers inputs are calibrated on the given samples,
+     * which should cover the range of the data the network will be used on.
+     *
+     * @param network The trained network, it is only read.
+     * @param calibration Stacked rows of normalized input values.
+     */
+    explicit QuantizedNetwork(const Network &network, const vd_t &calibration);
+
+    /**
+     * @return The number of layers in the network, including the output layer.
+     */
+    [[nodiscard]] std::size_t getSize() const;
+
+    /**
+     * @return The number of bytes used by the weights, biases and scales of all layers.
+     */
+    [[nodiscard]] std::size_t getParameterBytes() const;
+
+    /**
+     * Makes predictions based on input data.
+     *
+     * @param inputs Stacked rows of input values.
+     * @return Stacked rows of predicted values.
+     */
+    [[nodiscard]] vd_t predict(const vd_t &inputs) const;
+
+    /**
+     * Makes predictions based on input data, reusing the given buffers.
+     * No memory is allocated once the buffers are large enough.
+     *
+     * @param inputs Stacked rows of input values.
+     * @param outputs Stacked rows of predicted values, resized to fit.
+     * @param buffer Buffer for the intermediate results.
+     * @param quantized Buffer for the quantized inputs of each layer.
+     */
+    void predict(const vd_t &inputs, vd_t &outputs, vd_t &buffer, std::vector<std::int8_t> &quantized) const;
+};
+
+#endif //FRUIT_CLASSIFIER_WASM_QUANTIZED_NETWORK_H
@@ -0,0 +1,48 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#ifndef FRUIT_CLASSIFIER_WASM_SPAN_H
+#define FRUIT_CLASSIFIER_WASM_SPAN_H
+
+#include "nn.h"
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+template<typename T>
+class nn::Span {
+private:
+    T *first;
+    std::size_t count;
+
+public:
+    /**
+     * Constructs a view over a contiguous range of values.
+     * The view does not own the values, the storage must outlive it.
+     *
+     * @param first Pointer to the first value of the range.
+     * @param count Number of values in the range.
+     */
+    Span(T *first, std::size_t count) : first(first), count(count) {}
+
+    [[nodiscard]] T *data() const { return first; }
+
+    [[nodiscard]] std::size_t size() const { return count; }
+
+    [[nodiscard]] bool empty() const { return count == 0; }
+
+    [[nodiscard]] T *begin() const { return first; }
+
+    [[nodiscard]] T *end() const { return first + count; }
+
+    T &operator[](std::size_t index) const { return first[index]; }
+
+    /**
+     * @return A copy of the viewed values.
+     */
+    [[nodiscard]] std::vector<std::remove_const_t<T>> toVector() const { return {begin(), end()}; }
+};
+
+#endif //FRUIT_CLASSIFIER_WASM_SPAN_H
@@ -4,44 +4,184 @@
 
 #include "nn.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
 #include <valarray>
 #include <numeric>
 
+namespace {
+    using namespace nn;
+
+    act::Accuracy accuracy = act::Accuracy::Exact;
+
+    /**
+     * Branch-free exp approximation of finite inputs, written so the loops calling it vectorize: no compares,
+     * calls or float to integer conversions. Splits x / ln(2) into an integer part n, applied directly to the
+     * exponent bits, and a fraction in [-0.5, 0.5] evaluated with a degree 7 polynomial. Adding 1.5 * 2^mantissa
+     * rounds t to the nearest integer and leaves n in the low bits of the sum, which become the exponent of 2^n.
+     */
+    inline real_t fastExp(real_t x) {
+        using bits_t = std::conditional_t<std::is_same_v<real_t, float>, std::uint32_t, std::uint64_t>;
+        constexpr int mantissa = std::numeric_limits<real_t>::digits - 1;
+        constexpr int bias = std::numeric_limits<real_t>::max_exponent - 1;
+        constexpr real_t low = 1 - bias, high = bias;
+        constexpr real_t round = real_t(1.5) * real_t(bits_t(1) << mantissa);
+
+        // Clamped with abs instead of compares, which GCC only if-converts without -ftrapping-math.
+        // Each sum is exactly zero when t is in range, so t is kept as is.
+        real_t t = x * real_t(1.4426950408889634);
+        t += (std::abs(low - t) + (low - t)) / 2;
+        t -= (std::abs(t - high) + (t - high)) / 2;
+        real_t r = t + round;
+        real_t f = (t - (r - round)) * real_t(0.6931471805599453);
+
+        real_t p = real_t(1.0 / 5040);
+        p = p * f + real_t(1.0 / 720);
+        p = p * f + real_t(1.0 / 120);
+        p = p * f + real_t(1.0 / 24);
+        p = p * f + real_t(1.0 / 6);
+        p = p * f + real_t(0.5);
+        p = p * f + 1;
+        p = p * f + 1;
+
+        bits_t bits;
+        std::memcpy(&bits, &r, sizeof(bits));
+        bits = (bits + bias) << mantissa;
+        real_t scale;
+        std::memcpy(&scale, &bits, sizeof(scale));
+        return p * scale;
+    }
+
+    void stepFun(const real_t *x, real_t *y, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) { y[i] = x[i] >= 0 ? 1 : 0; }
+    }
+
+    void signFun(const real_t *x, real_t *y, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) { y[i] = x[i] >= 0 ? 1 : -1; }
+    }
+
+    void linearFun(const real_t *x, real_t *y, std::size_t n) {
+        if (x != y) { std::copy(x, x + n, y); }
+    }
+
+    void reluFun(const real_t *x, real_t *y, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) { y[i] = x[i] > 0 ? x[i] : 0; }
+    }
+
+    void sigmoidFun(const real_t *x, real_t *y, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) { y[i] = 1 / (1 + std::exp(-x[i])); }
+    }
+
+    void sigmoidFastFun(const real_t *x, real_t *y, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) { y[i] = 1 / (1 + fastExp(-x[i])); }
+    }
+
+    void tanhFun(const real_t *x, real_t *y, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) { y[i] = std::tanh(x[i]); }
+    }
+
+    void tanhFastFun(const real_t *x, real_t *y, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) { y[i] = 1 - 2 / (fastExp(2 * x[i]) + 1); }
+    }
+
+    void zeroDer(const real_t *, const real_t *, real_t *out, std::size_t n) {
+        std::fill(out, out + n, real_t(0));
+    }
+
+    void linearDer(const real_t *, const real_t *g, real_t *out, std::size_t n) {
+        if (g != out) { std::copy(g, g + n, out); }
+    }
+
+    void reluDer(const real_t *y, const real_t *g, real_t *out, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) { out[i] = y[i] > 0 ? g[i] : 0; }
+    }
+
+    void sigmoidDer(const real_t *y, const real_t *g, real_t *out, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) { out[i] = g[i] * y[i] * (1 - y[i]); }
+    }
+
+    void tanhDer(const real_t *y, const real_t *g, real_t *out, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) { out[i] = g[i] * (1 - y[i] * y[i]); }
+    }
+
+    const act::Kernel stepKernel{stepFun, zeroDer};
+    const act::Kernel signKernel{signFun, zeroDer};
+    const act::Kernel linearKernel{linearFun, linearDer};
+    const act::Kernel reluKernel{reluFun, reluDer};
+    const act::Kernel sigmoidKernel{sigmoidFun, sigmoidDer};
+    const act::Kernel sigmoidFastKernel{sigmoidFastFun, sigmoidDer};
+    const act::Kernel tanhKernel{tanhFun, tanhDer};
+    const act::Kernel tanhFastKernel{tanhFastFun, tanhDer};
+}
+
 namespace nn::act {
     Function step{
-            [](double x) -> double { return x >= 0 ? 1 : 0; },
-            [](double y) -> double { return 0; }
+            [](real_t x) -> real_t { return x >= 0 ? 1 : 0; },
+            [](real_t y) -> real_t { return 0; }
     };
 
     Function sign{
-            [](double x) -> double { return x >= 0 ? 1 : -1; },
-            [](double y) -> double { return 0; }
+            [](real_t x) -> real_t { return x >= 0 ? 1 : -1; },
+            [](real_t y) -> real_t { return 0; }
     };
 
     Function linear{
-            [](double x) -> double { return x; },
-            [](double y) -> double { return 1; }
+            [](real_t x) -> real_t { return x; },
+            [](real_t y) -> real_t { return 1; }
     };
 
     Function relu{
-            [](double x) -> double { return x > 0 ? x : 0; },
-            [](double y) -> double { return y > 0 ? 1 : 0; }
+            [](real_t x) -> real_t { return x > 0 ? x : 0; },
+            [](real_t y) -> real_t { return y > 0 ? 1 : 0; }
     };
 
     Function sigmoid{
-            [](double x) -> double { return 1 / (1 + std::exp(-x)); },
-            [](double y) -> double { return y * (1 - y); }
+            [](real_t x) -> real_t { return 1 / (1 + std::exp(-x)); },
+            [](real_t y) -> real_t { return y * (1 - y); }
     };
 
     Function tanh{
-            [](double x) -> double { return std::tanh(x); },
-            [](double y) -> double { return 1 - y * y; }
+            [](real_t x) -> real_t { return std::tanh(x); },
+            [](real_t y) -> real_t { return 1 - y * y; }
     };
 
+    void setAccuracy(Accuracy value) {
+        accuracy = value;
+    }
+
+    Accuracy getAccuracy() {
+        return accuracy;
+    }
+
+    const Kernel *kernel(const Function &function) {
+        bool fast = accuracy == Accuracy::Fast;
+        if (function.fun == sigmoid.fun) { return fast ? &sigmoidFastKernel : &sigmoidKernel; }
+        if (function.fun == tanh.fun) { return fast ? &tanhFastKernel : &tanhKernel; }
+        if (function.fun == relu.fun) { return &reluKernel; }
+        if (function.fun == linear.fun) { return &linearKernel; }
+        if (function.fun == step.fun) { return &stepKernel; }
+        if (function.fun == sign.fun) { return &signKernel; }
+        return nullptr;
+    }
+
     vd_t softmax(const vd_t &x) {
-        auto sum = std::accumulate(x.begin(), x.end(), 0.0, [](auto t, auto i) { return t + std::exp(i); });
         vd_t outputs(x);
-        std::transform(outputs.begin(), outputs.end(), outputs.begin(), [sum](auto i) { return std::exp(i) / sum; });
+        softmax(outputs.data(), outputs.size());
         return outputs;
     }
+
+    void softmax(real_t *values, std::size_t n) {
+        real_t max = *std::max_element(values, values + n);
+        real_t sum = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            values[i] = std::exp(values[i] - max);
+            sum += values[i];
+        }
+        real_t scale = 1 / sum;
+        for (std::size_t i = 0; i < n; ++i) { values[i] *= scale; }
+    }
 }
\ No newline at end of file
@@ -0,0 +1,78 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include "cross_validation.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <numeric>
+#include <random>
+
+using namespace nn;
+
+CrossValidation::CrossValidation(const Module &module, std::size_t folds) : base(module), k(folds) {
+    assert(k >= 2);
+}
+
+void CrossValidation::setThreads(std::size_t count) {
+    this->threads = count;
+}
+
+std::size_t CrossValidation::getThreads() const {
+    return threads;
+}
+
+void CrossValidation::setSeed(std::uint32_t value) {
+    this->seed = value;
+}
+
+std::vector<std::vector<std::size_t>> CrossValidation::folds() const {
+    std::vector<std::size_t> rows(base.getTrainSize());
+    assert(k <= rows.size());
+    std::iota(rows.begin(), rows.end(), 0);
+    std::mt19937 random(seed);
+    std::shuffle(rows.begin(), rows.end(), random);
+
+    std::vector<std::vector<std::size_t>> result(k);
+    for (std::size_t f = 0; f < k; ++f) {
+        auto from = rows.size() * f / k, to = rows.size() * (f + 1) / k;
+        result[f].assign(rows.begin() + from, rows.begin() + to);
+        // Ascending rows are visited in storage order while testing
+        std::sort(result[f].begin(), result[f].end());
+    }
+    return result;
+}
+
+CrossValidation::Result CrossValidation::run(std::size_t epochs, std::size_t batchSize) const {
+    auto testRows = folds();
+    Result result;
+    result.folds.resize(k);
+    std::atomic<std::size_t> next{0};
+
+    ThreadPool pool(std::min(threads == 0 ? ThreadPool::concurrency() : threads, k));
+    pool.run([&](std::size_t) {
+        for (auto f = next++; f < k; f = next++) {
+            Module module = base;
+            module.setThreads(1);
+            module.holdOut(testRows[f]);
+            Fold &fold = result.folds[f];
+            for (const auto &[train, test]: module.trainAndTest(epochs, batchSize)) {
+                fold.trainErrors.push_back(train);
+                fold.testErrors.push_back(test);
+            }
+        }
+    });
+
+    result.trainErrors.assign(epochs, 0);
+    result.testErrors.assign(epochs, 0);
+    for (const Fold &fold: result.folds) {
+        for (std::size_t e = 0; e < epochs; ++e) {
+            result.trainErrors[e] += fold.trainErrors[e] / static_cast<real_t>(k);
+            result.testErrors[e] += fold.testErrors[e] / static_cast<real_t>(k);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,255 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include "csv_codec.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace nn;
+
+namespace {
+    std::string_view trim(std::string_view text) {
+        while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) { text.remove_prefix(1); }
+        while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) { text.remove_suffix(1); }
+        return text;
+    }
+
+    /**
+     * Splits a line into trimmed fields, reusing the given vector.
+     */
+    void split(std::string_view line, std::vector<std::string_view> &fields) {
+        fields.clear();
+        for (std::size_t start = 0;;) {
+            auto end = line.find(',', start);
+            fields.push_back(trim(line.substr(start, end == std::string_view::npos ? end : end - start)));
+            if (end == std::string_view::npos) { break; }
+            start = end + 1;
+        }
+    }
+
+    /**
+     * Parses a numeric field, an empty field is read as zero.
+     * @return Whether the whole field is a number.
+     */
+    bool number(std::string_view field, real_t &value) {
+        if (field.empty()) {
+            value = 0;
+            return true;
+        }
+        std::string text(field);
+        char *end;
+        double parsed = std::strtod(text.c_str(), &end);
+        if (end != text.c_str() + text.size() || std::isnan(parsed)) { return false; }
+        value = static_cast<real_t>(parsed);
+        return true;
+    }
+
+    std::string format(real_t value) {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.15g", static_cast<double>(value));
+        return text;
+    }
+
+    /**
+     * Calls f for every line of the text.
+     */
+    template<typename F>
+    void linesOf(std::string_view text, F &&f) {
+        for (std::size_t start = 0; start < text.size();) {
+            auto end = std::min(text.find('\n', start), text.size());
+            f(text.substr(start, end - start));
+            start = end + 1;
+        }
+    }
+
+    /**
+     * Calls f for every line of the stream, reading it in chunks.
+     * Only the line split between two chunks is copied.
+     */
+    template<typename F>
+    void linesOf(std::istream &in, F &&f) {
+        std::string chunk(CsvCodec::chunkSize, '\0'), carry;
+        while (in) {
+            in.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+            std::string_view view(chunk.data(), static_cast<std::size_t>(in.gcount()));
+            auto first = view.find('\n');
+            if (first == std::string_view::npos) {
+                carry.append(view);
+                continue;
+            }
+            carry.append(view.substr(0, first));
+            f(std::string_view(carry));
+            // The lines between the first and the last newline are whole, a single newline leaves none
+            auto last = view.rfind('\n');
+            if (last > first) { linesOf(view.substr(first + 1, last - first - 1), f); }
+            carry.assign(view.substr(last + 1));
+        }
+        if (!carry.empty()) { f(std::string_view(carry)); }
+    }
+}
+
+std::size_t CsvCodec::Column::add(const std::string &category) {
+    auto [i, added] = index.emplace(category, categories.size());
+    if (added) { categories.push_back(category); }
+    return i->second;
+}
+
+CsvCodec::CsvCodec(Encoding encoding) : encoding(encoding) {}
+
+template<typename Source>
+CsvCodec::Table CsvCodec::learn(Source &&source, const std::string &headerPrefix) {
+    columns.clear();
+    headers = false;
+    Table table;
+    std::vector<std::string_view> fields;
+    bool first = true;
+    source([&](std::string_view line) {
+        if (trim(line).empty()) { return; }
+        split(line, fields);
+        if (first) {
+            first = false;
+            real_t value;
+            table.width = fields.size();
+            columns.resize(fields.size());
+            headers = std::none_of(fields.begin(), fields.end(), [&](auto field) { return number(field, value); });
+            for (std::size_t i = 0; i < fields.size(); ++i) {
+                columns[i].header = headers ? std::string(fields[i]) : headerPrefix + std::to_string(i + 1);
+            }
+            if (headers) { return; }
+        }
+        for (std::size_t i = 0; i < table.width; ++i) {
+            auto field = i < fields.size() ? fields[i] : std::string_view();
+            auto &column = columns[i];
+            real_t value;
+            if (!column.categorical && number(field, value)) {
+                table.values.push_back(value);
+                continue;
+            }
+            if (!column.categorical) {
+                // Numbers read before the first category become categories themselves.
+                column.categorical = true;
+                for (std::size_t r = 0; r < table.values.size() / table.width; ++r) {
+                    auto &v = table.values[r * table.width + i];
+                    v = static_cast<real_t>(column.add(format(v)));
+                }
+            }
+            table.values.push_back(static_cast<real_t>(column.add(std::string(field))));
+        }
+    });
+    return table;
+}
+
+template<typename Source>
+CsvCodec::Table CsvCodec::read(Source &&source) const {
+    Table table;
+    table.width = columns.size();
+    std::vector<std::string_view> fields;
+    bool skip = headers, detect = columns.empty();
+    source([&](std::string_view line) {
+        if (trim(line).empty()) { return; }
+        split(line, fields);
+        if (detect) {
+            // Without fitted columns the headers are detected like fit does
+            detect = false;
+            real_t value;
+            skip = std::none_of(fields.begin(), fields.end(), [&](auto field) { return number(field, value); });
+        }
+        if (skip) {
+            skip = false;
+            return;
+        }
+        if (table.width == 0) { table.width = fields.size(); }
+        for (std::size_t i = 0; i < table.width; ++i) {
+            auto field = i < fields.size() ? fields[i] : std::string_view();
+            real_t value = 0;
+            if (i < columns.size() && columns[i].categorical) {
+                auto category = columns[i].index.find(std::string(field));
+                value = category == columns[i].index.end() ? -1 : static_cast<real_t>(category->second);
+            } else if (!number(field, value)) {
+                value = 0;
+            }
+            table.values.push_back(value);
+        }
+    });
+    return table;
+}
+
+vvd_t CsvCodec::expand(const Table &table) const {
+    if (table.width == 0) { return {}; }
+    vvd_t rows(table.values.size() / table.width);
+    auto width = getHeaders(true).size();
+    auto v = table.values.cbegin();
+    for (auto &row: rows) {
+        row.reserve(std::max(width, table.width));
+        for (std::size_t i = 0; i < table.width; ++i, ++v) {
+            if (encoding == Encoding::OneHot && i < columns.size() && columns[i].categorical) {
+                for (std::size_t c = 0; c < columns[i].categories.size(); ++c) {
+                    row.push_back(*v == static_cast<real_t>(c) ? 1 : 0);
+                }
+            } else {
+                row.push_back(*v);
+            }
+        }
+    }
+    return rows;
+}
+
+vvd_t CsvCodec::fit(std::istream &in, const std::string &headerPrefix) {
+    return expand(learn([&](auto &&f) { linesOf(in, f); }, headerPrefix));
+}
+
+vvd_t CsvCodec::fit(std::string_view text, const std::string &headerPrefix) {
+    return expand(learn([&](auto &&f) { linesOf(text, f); }, headerPrefix));
+}
+
+vvd_t CsvCodec::encode(std::istream &in) const {
+    return expand(read([&](auto &&f) { linesOf(in, f); }));
+}
+
+vvd_t CsvCodec::encode(std::string_view text) const {
+    return expand(read([&](auto &&f) { linesOf(text, f); }));
+}
+
+std::vector<std::string> CsvCodec::decode(const real_t *row) const {
+    std::vector<std::string> values;
+    values.reserve(columns.size());
+    for (const auto &column: columns) {
+        if (!column.categorical) {
+            values.push_back(format(*row++));
+        } else if (encoding == Encoding::OneHot) {
+            auto count = column.categories.size();
+            values.push_back(column.categories[std::max_element(row, row + count) - row]);
+            row += count;
+        } else {
+            auto last = static_cast<real_t>(column.categories.size() - 1);
+            auto index = std::clamp(std::round(*row++), real_t(0), last);
+            values.push_back(column.categories[static_cast<std::size_t>(index)]);
+        }
+    }
+    return values;
+}
+
+CsvCodec::Encoding CsvCodec::getEncoding() const {
+    return encoding;
+}
+
+std::vector<std::string> CsvCodec::getHeaders(bool encoded) const {
+    std::vector<std::string> result;
+    for (const auto &column: columns) {
+        if (encoded && encoding == Encoding::OneHot && column.categorical) {
+            for (const auto &category: column.categories) { result.push_back(column.header + "_" + category); }
+        } else {
+            result.push_back(column.header);
+        }
+    }
+    return result;
+}
+
+const std::vector<std::string> &CsvCodec::getCategories(std::size_t column) const {
+    return columns[column].categories;
+}
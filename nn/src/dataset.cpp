@@ -0,0 +1,120 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include "dataset.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace nn;
+
+Dataset::Dataset(const vvd_t &rows) {
+    set(rows);
+}
+
+Dataset::Dataset(const real_t *data, std::size_t rows, std::size_t width) {
+    set(data, rows, width);
+}
+
+void Dataset::set(const vvd_t &rows) {
+    columns = rows.empty() ? 0 : rows.front().size();
+    values.clear();
+    values.reserve(rows.size() * columns);
+    for (const vd_t &row: rows) {
+        assert(row.size() == columns);
+        values.insert(values.end(), row.begin(), row.end());
+    }
+    cached = false;
+}
+
+void Dataset::set(const real_t *data, std::size_t rows, std::size_t width) {
+    columns = width;
+    values.assign(data, data + rows * width);
+    cached = false;
+}
+
+void Dataset::clear() {
+    values.clear();
+    columns = 0;
+    cached = false;
+}
+
+std::size_t Dataset::size() const {
+    return columns == 0 ? 0 : values.size() / columns;
+}
+
+std::size_t Dataset::width() const {
+    return columns;
+}
+
+bool Dataset::empty() const {
+    return values.empty();
+}
+
+const vd_t &Dataset::data() const {
+    return values;
+}
+
+csd_t Dataset::row(std::size_t index) const {
+    return rows(index, index + 1);
+}
+
+csd_t Dataset::rows(std::size_t from, std::size_t to) const {
+    assert(from <= to && to <= size());
+    return {values.data() + from * columns, (to - from) * columns};
+}
+
+vvd_t Dataset::toRows() const {
+    vvd_t out(size());
+    for (std::size_t i = 0; i < out.size(); ++i) { out[i] = row(i).toVector(); }
+    return out;
+}
+
+void Dataset::fitMinMax() {
+    vpd_t fitted;
+    fitted.reserve(columns);
+    for (std::size_t i = 0; i < columns; ++i) {
+        real_t minParam = values[i];
+        real_t maxParam = values[i];
+        for (std::size_t j = i + columns; j < values.size(); j += columns) {
+            minParam = std::min(minParam, values[j]);
+            maxParam = std::max(maxParam, values[j]);
+        }
+        fitted.emplace_back(minParam, maxParam);
+    }
+    setMinMax(fitted);
+}
+
+void Dataset::setMinMax(const vpd_t &params) {
+    if (params == minMax) { return; }
+    minMax = params;
+    cached = false;
+}
+
+const vpd_t &Dataset::getMinMax() const {
+    return minMax;
+}
+
+const vd_t &Dataset::normalized() const {
+    if (!cached) {
+        assert(empty() || minMax.size() == columns);
+        normalizedValues.resize(values.size());
+        if (!empty()) { normalize(values.data(), normalizedValues.data(), values.size()); }
+        cached = true;
+    }
+    return normalizedValues;
+}
+
+csd_t Dataset::normalized(std::size_t from, std::size_t to) const {
+    assert(from <= to && to <= size());
+    return {normalized().data() + from * columns, (to - from) * columns};
+}
+
+void Dataset::normalize(const real_t *original, real_t *out, std::size_t n) const {
+    process::minmax(original, out, n, minMax);
+}
+
+void Dataset::denormalize(const real_t *processed, real_t *out, std::size_t n) const {
+    process::inverseMinmax(processed, out, n, minMax);
+}
@@ -0,0 +1,166 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include "ensemble.h"
+#include "module.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <random>
+#include <stdexcept>
+
+using namespace nn;
+
+Ensemble::Ensemble(const std::vector<Network> &networks, Aggregation aggregation)
+        : members(networks.size()), aggregation(aggregation) {
+    if (networks.empty()) { throw std::invalid_argument("An ensemble needs at least one network"); }
+    const Network &first = networks.front();
+    auto function = [](const Layer &layer) { return static_cast<const HiddenLayer &>(layer).getFunction().fun; };
+    for (const Network &network: networks) {
+        if (network.getSize() != first.getSize()) { throw std::invalid_argument("The networks differ in depth"); }
+        for (std::size_t i = 0; i < first.getSize(); ++i) {
+            const Layer &layer = network.get(i), &reference = first.get(i);
+            if (layer.getInputSize() != reference.getInputSize() || layer.size() != reference.size()) {
+                throw std::invalid_argument("The networks differ in dimensions");
+            }
+            if (i + 1 < first.getSize() && function(layer) != function(reference)) {
+                throw std::invalid_argument("The networks differ in hidden activations");
+            }
+        }
+    }
+    layers.reserve(first.getSize());
+    for (std::size_t i = 0; i < first.getSize(); ++i) {
+        const Layer &layer = first.get(i);
+        bool last = i + 1 == first.getSize();
+        Dense dense{layer.getInputSize(), layer.size(), {}, {},
+                    last ? act::linear : static_cast<const HiddenLayer &>(layer).getFunction()};
+        auto stacked = members * dense.size;
+        dense.weights.resize(dense.inputs * stacked);
+        dense.biases.reserve(stacked);
+        for (std::size_t m = 0; m < members; ++m) {
+            const Layer &member = networks[m].get(i);
+            for (std::size_t n = 0; n < dense.size; ++n) {
+                auto w = member.getWeights(n);
+                auto column = m * dense.size + n;
+                for (std::size_t j = 0; j < dense.inputs; ++j) { dense.weights[j * stacked + column] = w[j]; }
+            }
+            dense.biases.insert(dense.biases.end(), member.getBiases().begin(), member.getBiases().end());
+        }
+        layers.push_back(std::move(dense));
+    }
+}
+
+Ensemble Ensemble::bag(const Module &module, const std::vector<Network> &networks, std::size_t epochs,
+                       std::size_t batchSize, std::uint32_t seed) {
+    // The samples are drawn up front, so they don't depend on the order the workers pick the networks in
+    auto rows = module.getTrainSize();
+    assert(rows > 0);
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<std::size_t> pick(0, rows - 1);
+    std::vector<std::vector<std::size_t>> samples(networks.size(), std::vector<std::size_t>(rows));
+    for (auto &sample: samples) {
+        for (auto &i: sample) { i = pick(random); }
+        // Sorted rows are read in storage order by sequential epochs
+        std::sort(sample.begin(), sample.end());
+    }
+
+    std::vector<Network> trained(networks);
+    std::atomic<std::size_t> next{0};
+    auto threads = module.getThreads() == 0 ? ThreadPool::concurrency() : module.getThreads();
+    ThreadPool pool(std::min(threads, networks.size()));
+    pool.run([&](std::size_t) {
+        for (auto m = next++; m < networks.size(); m = next++) {
+            Module member = module;
+            member.setThreads(1);
+            member.setNetwork(networks[m]);
+            member.setTrainRows(samples[m]);
+            (void) member.train(epochs, batchSize);
+            trained[m].setParameters(member.getNetwork());
+        }
+    });
+    return Ensemble(trained);
+}
+
+std::size_t Ensemble::getSize() const {
+    return members;
+}
+
+void Ensemble::setAggregation(Aggregation value) {
+    this->aggregation = value;
+}
+
+Ensemble::Aggregation Ensemble::getAggregation() const {
+    return aggregation;
+}
+
+void Ensemble::activate(const Dense &layer, bool shared, const vd_t &inputs, vd_t &outputs, bool last) const {
+    auto width = shared ? layer.inputs : members * layer.inputs, stacked = members * layer.size;
+    outputs.resize(Layer::rows(inputs, width) * stacked);
+    auto r = outputs.data();
+    for (auto x = inputs.data(); x != inputs.data() + inputs.size(); x += width, r += stacked) {
+        // Every input adds its column of the stacked weights to the outputs of all the members at once
+        std::copy(layer.biases.begin(), layer.biases.end(), r);
+        for (std::size_t j = 0; j < layer.inputs; ++j) {
+            const real_t *w = layer.weights.data() + j * stacked;
+            if (shared) {
+                kernel::axpy(x[j], w, r, stacked);
+                continue;
+            }
+            for (std::size_t m = 0; m < members; ++m) {
+                kernel::axpy(x[m * layer.inputs + j], w + m * layer.size, r + m * layer.size, layer.size);
+            }
+        }
+    }
+
+    // Every member's outputs are a slice of layer.size values, so the activations run over all of them at once
+    if (!last) {
+        if (auto k = act::kernel(layer.function)) { return k->fun(outputs.data(), outputs.data(), outputs.size()); }
+        std::transform(outputs.begin(), outputs.end(), outputs.begin(), layer.function.fun);
+    } else if (layer.size == 1) {
+        act::kernel(act::sigmoid)->fun(outputs.data(), outputs.data(), outputs.size());
+    } else {
+        for (auto o = outputs.data(); o != outputs.data() + outputs.size(); o += layer.size) {
+            act::softmax(o, layer.size);
+        }
+    }
+}
+
+void Ensemble::aggregate(const vd_t &stacked, vd_t &outputs) const {
+    auto n = layers.back().size, width = members * n;
+    auto rows = Layer::rows(stacked, width);
+    outputs.assign(rows * n, 0);
+    auto weight = 1 / static_cast<real_t>(members);
+    for (std::size_t row = 0; row < rows; ++row) {
+        const real_t *y = stacked.data() + row * width;
+        real_t *out = outputs.data() + row * n;
+        for (std::size_t m = 0; m < members; ++m, y += n) {
+            if (aggregation == Aggregation::Mean) {
+                for (std::size_t j = 0; j < n; ++j) { out[j] += y[j] * weight; }
+            } else if (n == 1) {
+                out[0] += y[0] >= 0.5 ? weight : 0;
+            } else {
+                out[std::max_element(y, y + n) - y] += weight;
+            }
+        }
+    }
+}
+
+vd_t Ensemble::predict(const vd_t &inputs) const {
+    vd_t outputs, buffer, stacked;
+    predict(inputs, outputs, buffer, stacked);
+    return outputs;
+}
+
+void Ensemble::predict(const vd_t &inputs, vd_t &outputs, vd_t &buffer, vd_t &stacked) const {
+    const vd_t *x = &inputs;
+    for (std::size_t i = 0; i < layers.size(); ++i) {
+        // Alternate between the buffers so the output layer writes into stacked.
+        vd_t &y = (layers.size() - i) % 2 == 1 ? stacked : buffer;
+        activate(layers[i], i == 0, *x, y, i + 1 == layers.size());
+        x = &y;
+    }
+    aggregate(stacked, outputs);
+}
@@ -0,0 +1,318 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include "nn.h"
+
+#if !defined(NN_SCALAR_KERNELS) && defined(__AVX2__)
+#define NN_KERNEL_AVX2
+#include <immintrin.h>
+#elif !defined(NN_SCALAR_KERNELS) && defined(__SSE2__) && defined(__GNUC__) \
+    && (defined(__x86_64__) || defined(__i386__))
+// Generic x86 builds also carry AVX2 kernels, picked at run time when the CPU has AVX2 and FMA
+#define NN_KERNEL_SSE2
+#define NN_KERNEL_DISPATCH
+#include <immintrin.h>
+#elif !defined(NN_SCALAR_KERNELS) && defined(__SSE2__)
+#define NN_KERNEL_SSE2
+#include <emmintrin.h>
+#elif !defined(NN_SCALAR_KERNELS) && defined(__wasm_simd128__)
+#define NN_KERNEL_SIMD128
+#include <wasm_simd128.h>
+#else
+#define NN_KERNEL_SCALAR
+#endif
+
+// Functions using AVX2 in a build for a generic CPU are compiled for AVX2 and FMA on their own
+#ifdef NN_KERNEL_DISPATCH
+#define NN_AVX2 __attribute__((target("avx2,fma")))
+// The generic kernels pass AVX2 registers around, but they're always inlined into the AVX2 functions
+#pragma GCC diagnostic ignored "-Wpsabi"
+#else
+#define NN_AVX2
+#endif
+
+using namespace nn;
+
+namespace {
+    /**
+     * Thin wrappers over the vector registers of an instruction set, one specialization per scalar type.
+     */
+    template<typename T>
+    struct Avx2;
+
+    template<typename T>
+    struct Sse2;
+
+    template<typename T>
+    struct Simd128;
+
+#if defined(NN_KERNEL_AVX2) || defined(NN_KERNEL_DISPATCH)
+
+    template<>
+    struct Avx2<double> {
+        using reg = __m256d;
+        static constexpr std::size_t lanes = 4;
+
+        NN_AVX2 static reg zero() { return _mm256_setzero_pd(); }
+
+        NN_AVX2 static reg splat(double x) { return _mm256_set1_pd(x); }
+
+        NN_AVX2 static reg load(const double *p) { return _mm256_loadu_pd(p); }
+
+        NN_AVX2 static void store(double *p, reg v) { _mm256_storeu_pd(p, v); }
+
+        NN_AVX2 static reg add(reg a, reg b) { return _mm256_add_pd(a, b); }
+
+        NN_AVX2 static reg mul(reg a, reg b) { return _mm256_mul_pd(a, b); }
+
+#if defined(__FMA__) || defined(NN_KERNEL_DISPATCH)
+        NN_AVX2 static reg madd(reg a, reg b, reg acc) { return _mm256_fmadd_pd(a, b, acc); }
+#else
+        NN_AVX2 static reg madd(reg a, reg b, reg acc) { return add(acc, mul(a, b)); }
+#endif
+
+        NN_AVX2 static double sum(reg v) {
+            __m128d half = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+            return _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+        }
+    };
+
+    template<>
+    struct Avx2<float> {
+        using reg = __m256;
+        static constexpr std::size_t lanes = 8;
+
+        NN_AVX2 static reg zero() { return _mm256_setzero_ps(); }
+
+        NN_AVX2 static reg splat(float x) { return _mm256_set1_ps(x); }
+
+        NN_AVX2 static reg load(const float *p) { return _mm256_loadu_ps(p); }
+
+        NN_AVX2 static void store(float *p, reg v) { _mm256_storeu_ps(p, v); }
+
+        NN_AVX2 static reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+
+        NN_AVX2 static reg mul(reg a, reg b) { return _mm256_mul_ps(a, b); }
+
+#if defined(__FMA__) || defined(NN_KERNEL_DISPATCH)
+        NN_AVX2 static reg madd(reg a, reg b, reg acc) { return _mm256_fmadd_ps(a, b, acc); }
+#else
+        NN_AVX2 static reg madd(reg a, reg b, reg acc) { return add(acc, mul(a, b)); }
+#endif
+
+        NN_AVX2 static float sum(reg v) {
+            __m128 quad = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+            __m128 pair = _mm_add_ps(quad, _mm_movehl_ps(quad, quad));
+            return _mm_cvtss_f32(_mm_add_ss(pair, _mm_shuffle_ps(pair, pair, 1)));
+        }
+    };
+
+#endif
+
+#if defined(NN_KERNEL_SSE2)
+
+    template<>
+    struct Sse2<double> {
+        using reg = __m128d;
+        static constexpr std::size_t lanes = 2;
+
+        static reg zero() { return _mm_setzero_pd(); }
+
+        static reg splat(double x) { return _mm_set1_pd(x); }
+
+        static reg load(const double *p) { return _mm_loadu_pd(p); }
+
+        static void store(double *p, reg v) { _mm_storeu_pd(p, v); }
+
+        static reg add(reg a, reg b) { return _mm_add_pd(a, b); }
+
+        static reg mul(reg a, reg b) { return _mm_mul_pd(a, b); }
+
+        static reg madd(reg a, reg b, reg acc) { return add(acc, mul(a, b)); }
+
+        static double sum(reg v) { return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v))); }
+    };
+
+    template<>
+    struct Sse2<float> {
+        using reg = __m128;
+        static constexpr std::size_t lanes = 4;
+
+        static reg zero() { return _mm_setzero_ps(); }
+
+        static reg splat(float x) { return _mm_set1_ps(x); }
+
+        static reg load(const float *p) { return _mm_loadu_ps(p); }
+
+        static void store(float *p, reg v) { _mm_storeu_ps(p, v); }
+
+        static reg add(reg a, reg b) { return _mm_add_ps(a, b); }
+
+        static reg mul(reg a, reg b) { return _mm_mul_ps(a, b); }
+
+        static reg madd(reg a, reg b, reg acc) { return add(acc, mul(a, b)); }
+
+        static float sum(reg v) {
+            __m128 pair = _mm_add_ps(v, _mm_movehl_ps(v, v));
+            return _mm_cvtss_f32(_mm_add_ss(pair, _mm_shuffle_ps(pair, pair, 1)));
+        }
+    };
+
+#elif defined(NN_KERNEL_SIMD128)
+
+    template<>
+    struct Simd128<double> {
+        using reg = v128_t;
+        static constexpr std::size_t lanes = 2;
+
+        static reg zero() { return wasm_f64x2_splat(0); }
+
+        static reg splat(double x) { return wasm_f64x2_splat(x); }
+
+        static reg load(const double *p) { return wasm_v128_load(p); }
+
+        static void store(double *p, reg v) { wasm_v128_store(p, v); }
+
+        static reg add(reg a, reg b) { return wasm_f64x2_add(a, b); }
+
+        static reg mul(reg a, reg b) { return wasm_f64x2_mul(a, b); }
+
+        static reg madd(reg a, reg b, reg acc) { return add(acc, mul(a, b)); }
+
+        static double sum(reg v) { return wasm_f64x2_extract_lane(v, 0) + wasm_f64x2_extract_lane(v, 1); }
+    };
+
+    template<>
+    struct Simd128<float> {
+        using reg = v128_t;
+        static constexpr std::size_t lanes = 4;
+
+        static reg zero() { return wasm_f32x4_splat(0); }
+
+        static reg splat(float x) { return wasm_f32x4_splat(x); }
+
+        static reg load(const float *p) { return wasm_v128_load(p); }
+
+        static void store(float *p, reg v) { wasm_v128_store(p, v); }
+
+        static reg add(reg a, reg b) { return wasm_f32x4_add(a, b); }
+
+        static reg mul(reg a, reg b) { return wasm_f32x4_mul(a, b); }
+
+        static reg madd(reg a, reg b, reg acc) { return add(acc, mul(a, b)); }
+
+        static float sum(reg v) {
+            return (wasm_f32x4_extract_lane(v, 0) + wasm_f32x4_extract_lane(v, 1)) +
+                   (wasm_f32x4_extract_lane(v, 2) + wasm_f32x4_extract_lane(v, 3));
+        }
+    };
+
+#endif
+
+#if defined(NN_KERNEL_AVX2)
+    template<typename T>
+    using Simd = Avx2<T>;
+#elif defined(NN_KERNEL_SSE2)
+    template<typename T>
+    using Simd = Sse2<T>;
+#elif defined(NN_KERNEL_SIMD128)
+    template<typename T>
+    using Simd = Simd128<T>;
+#endif
+
+#if !defined(NN_KERNEL_SCALAR)
+
+    // Inlined into the dispatched functions, so the AVX2 wrappers are compiled for AVX2 there
+    template<typename S>
+    __attribute__((always_inline)) inline real_t dotOf(const real_t *a, const real_t *b, std::size_t n) {
+        constexpr auto lanes = S::lanes;
+        typename S::reg acc0 = S::zero(), acc1 = S::zero();
+        std::size_t i = 0;
+        for (; i + 2 * lanes <= n; i += 2 * lanes) {
+            acc0 = S::madd(S::load(a + i), S::load(b + i), acc0);
+            acc1 = S::madd(S::load(a + i + lanes), S::load(b + i + lanes), acc1);
+        }
+        for (; i + lanes <= n; i += lanes) {
+            acc0 = S::madd(S::load(a + i), S::load(b + i), acc0);
+        }
+        real_t sum = S::sum(S::add(acc0, acc1));
+        for (; i < n; ++i) { sum += a[i] * b[i]; }
+        return sum;
+    }
+
+    template<typename S>
+    __attribute__((always_inline)) inline void axpyOf(real_t alpha, const real_t *x, real_t *y, std::size_t n) {
+        constexpr auto lanes = S::lanes;
+        typename S::reg factor = S::splat(alpha);
+        std::size_t i = 0;
+        for (; i + lanes <= n; i += lanes) {
+            S::store(y + i, S::madd(factor, S::load(x + i), S::load(y + i)));
+        }
+        for (; i < n; ++i) { y[i] += alpha * x[i]; }
+    }
+
+#endif
+
+#ifdef NN_KERNEL_DISPATCH
+
+    NN_AVX2 real_t dotAvx2(const real_t *a, const real_t *b, std::size_t n) {
+        return dotOf<Avx2<real_t>>(a, b, n);
+    }
+
+    NN_AVX2 void axpyAvx2(real_t alpha, const real_t *x, real_t *y, std::size_t n) {
+        axpyOf<Avx2<real_t>>(alpha, x, y, n);
+    }
+
+    const bool avx2 = [] {
+        // Required before __builtin_cpu_supports runs in static initialization
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    }();
+
+#endif
+}
+
+const char *kernel::name() {
+#if defined(NN_KERNEL_AVX2)
+    return "avx2";
+#elif defined(NN_KERNEL_DISPATCH)
+    return avx2 ? "avx2" : "sse2";
+#elif defined(NN_KERNEL_SSE2)
+    return "sse2";
+#elif defined(NN_KERNEL_SIMD128)
+    return "simd128";
+#else
+    return "scalar";
+#endif
+}
+
+#if defined(NN_KERNEL_SCALAR)
+
+real_t kernel::dot(const real_t *a, const real_t *b, std::size_t n) {
+    real_t sum = 0;
+    for (std::size_t i = 0; i < n; ++i) { sum += a[i] * b[i]; }
+    return sum;
+}
+
+void kernel::axpy(real_t alpha, const real_t *x, real_t *y, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) { y[i] += alpha * x[i]; }
+}
+
+#else
+
+real_t kernel::dot(const real_t *a, const real_t *b, std::size_t n) {
+#ifdef NN_KERNEL_DISPATCH
+    if (avx2) { return dotAvx2(a, b, n); }
+#endif
+    return dotOf<Simd<real_t>>(a, b, n);
+}
+
+void kernel::axpy(real_t alpha, const real_t *x, real_t *y, std::size_t n) {
+#ifdef NN_KERNEL_DISPATCH
+    if (avx2) { return axpyAvx2(alpha, x, y, n); }
+#endif
+    axpyOf<Simd<real_t>>(alpha, x, y, n);
+}
+
+#endif
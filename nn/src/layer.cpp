@@ -12,11 +12,63 @@
 
 using namespace nn;
 
-Layer::Layer(vn_t neurons) : vn_t(std::move(neurons)), output_cash(size()), gradient_cash(size()) {}
+Layer::Layer(const vn_t &neurons)
+        : inputs(neurons.empty() ? 0 : neurons.begin()->size()),
+          output_cash(neurons.size()), gradient_cash(neurons.size()) {
+    weights.reserve(neurons.size() * inputs);
+    biases.reserve(neurons.size());
+    for (const Neuron &n: neurons) {
+        assert(n.size() == inputs);
+        weights.insert(weights.end(), n.begin(), n.end());
+        biases.push_back(n.getBias());
+    }
+}
+
+HiddenLayer::HiddenLayer(const vn_t &neurons, act::Function function) : Layer(neurons), function(function) {}
+
+const act::Function &HiddenLayer::getFunction() const {
+    return function;
+}
+
+OutputLayer::OutputLayer(const vn_t &neurons) : Layer(neurons) {}
+
+std::size_t Layer::size() const {
+    return biases.size();
+}
 
-HiddenLayer::HiddenLayer(vn_t neurons, act::Function function) : Layer(std::move(neurons)), function(function) {}
+std::size_t Layer::getInputSize() const {
+    return inputs;
+}
+
+csd_t Layer::getWeights(std::size_t neuron) const {
+    assert(neuron < size());
+    return {weights.data() + neuron * inputs, inputs};
+}
+
+sd_t Layer::getWeights(std::size_t neuron) {
+    assert(neuron < size());
+    return {weights.data() + neuron * inputs, inputs};
+}
+
+const vd_t &Layer::getWeights() const {
+    return weights;
+}
 
-OutputLayer::OutputLayer(vn_t neurons) : Layer(std::move(neurons)) {}
+real_t Layer::getBias(std::size_t neuron) const {
+    return biases[neuron];
+}
+
+const vd_t &Layer::getBiases() const {
+    return biases;
+}
+
+Neuron Layer::getNeuron(std::size_t neuron) const {
+    return Neuron(getWeights(neuron).toVector(), getBias(neuron));
+}
+
+bool Layer::operator==(const Layer &other) const {
+    return inputs == other.inputs && weights == other.weights && biases == other.biases;
+}
 
 const vd_t &Layer::getOutputCash() const {
     return output_cash;
@@ -26,55 +78,170 @@ const vd_t &Layer::getGradientCash() const {
     return gradient_cash;
 }
 
+std::size_t Layer::rows(const vd_t &values, std::size_t width) {
+    assert(width > 0 && values.size() % width == 0);
+    return values.size() / width;
+}
+
 vd_t Layer::process(const vd_t &inputs) const {
-    vd_t res(size());
-    std::transform(begin(), end(), res.begin(), [&inputs](auto &n) { return n.process(inputs); });
+    vd_t res;
+    process(inputs, res);
     return res;
 }
 
-vd_t Layer::activateAndCache(const vd_t &inputs) {
-    return output_cash = activate(inputs);
+void Layer::process(const vd_t &inputs, vd_t &outputs) const {
+    outputs.resize(rows(inputs, this->inputs) * size());
+    auto r = outputs.begin();
+    for (auto x = inputs.data(); r != outputs.end(); x += this->inputs) {
+        auto w = weights.data();
+        for (std::size_t i = 0; i < size(); ++i, ++r, w += this->inputs) {
+            *r = kernel::dot(w, x, this->inputs) + biases[i];
+        }
+    }
 }
 
-vd_t HiddenLayer::activate(const vd_t &inputs) const {
-    vd_t res = Layer::process(inputs);
-    std::transform(res.begin(), res.end(), res.begin(), this->function.fun);
+vd_t Layer::activate(const vd_t &inputs) const {
+    vd_t res;
+    activate(inputs, res);
     return res;
 }
 
-vd_t OutputLayer::activate(const vd_t &inputs) const {
-    vd_t res = Layer::process(inputs);
-    if (size() == 1) { return {act::sigmoid.fun(res[0])}; }
-    return act::softmax(res);
+const vd_t &Layer::activateAndCache(const vd_t &inputs) {
+    activate(inputs, output_cash);
+    return output_cash;
 }
 
-vd_t Layer::propagateErrorBackward() const {
-    vd_t e(begin()->size());
-    for (std::size_t i = 0; i < e.size(); ++i) {
-        auto g = gradient_cash.begin();
-        for (auto n = begin(); n != end(); ++n, ++g) { e[i] += (*n)[i] * (*g); }
+void HiddenLayer::activate(const vd_t &inputs, vd_t &outputs) const {
+    Layer::process(inputs, outputs);
+    if (auto k = act::kernel(function)) { return k->fun(outputs.data(), outputs.data(), outputs.size()); }
+    std::transform(outputs.begin(), outputs.end(), outputs.begin(), this->function.fun);
+}
+
+void OutputLayer::activate(const vd_t &inputs, vd_t &outputs) const {
+    Layer::process(inputs, outputs);
+    if (size() == 1) { return act::kernel(act::sigmoid)->fun(outputs.data(), outputs.data(), outputs.size()); }
+    for (auto r = outputs.data(); r != outputs.data() + outputs.size(); r += size()) {
+        act::softmax(r, size());
     }
+}
+
+real_t OutputLayer::activateWithCrossEntropy(const vd_t &inputs, const vd_t &desired) {
+    assert(size() > 1);
+    Layer::process(inputs, output_cash);
+    assert(output_cash.size() == desired.size());
+    gradient_cash.resize(output_cash.size());
+    real_t sum = 0;
+    for (std::size_t r = 0; r < output_cash.size(); r += size()) {
+        sum += loss::softmaxCrossEntropy(output_cash.data() + r, desired.data() + r, gradient_cash.data() + r, size());
+    }
+    return sum;
+}
+
+vd_t Layer::propagateErrorBackward() const {
+    vd_t e;
+    propagateErrorBackward(e);
     return e;
 }
 
-vd_t Layer::calculateGradientsAndCash(const vd_t &intermediateGradients) {
-    return gradient_cash = calculateGradients(intermediateGradients);
+void Layer::propagateErrorBackward(vd_t &errors) const {
+    errors.assign(rows(gradient_cash, size()) * inputs, 0);
+    auto g = gradient_cash.begin();
+    for (auto r = errors.data(); r != errors.data() + errors.size(); r += inputs) {
+        auto w = weights.data();
+        for (std::size_t j = 0; j < size(); ++j, ++g, w += inputs) { kernel::axpy(*g, w, r, inputs); }
+    }
+}
+
+vd_t Layer::calculateGradients(const vd_t &intermediateGradients) const {
+    vd_t gradients;
+    calculateGradients(intermediateGradients, gradients);
+    return gradients;
+}
+
+const vd_t &Layer::calculateGradientsAndCash(const vd_t &intermediateGradients) {
+    calculateGradients(intermediateGradients, gradient_cash);
+    return gradient_cash;
+}
+
+void Layer::adjust(const vd_t &inputs, real_t alpha) {
+    auto n = rows(inputs, this->inputs);
+    assert(n * size() == gradient_cash.size());
+    real_t rate = alpha / static_cast<real_t>(n);
+    auto g = gradient_cash.begin();
+    for (auto x = inputs.data(); x != inputs.data() + inputs.size(); x += this->inputs) {
+        auto w = weights.data();
+        for (std::size_t j = 0; j < size(); ++j, ++g, w += this->inputs) {
+            real_t factor = -1 * rate * (*g);
+            kernel::axpy(factor, x, w, this->inputs);
+            biases[j] += factor;
+        }
+    }
+}
+
+void Layer::accumulate(const vd_t &inputs, vd_t &weightGradients, vd_t &biasGradients) const {
+    assert(weightGradients.size() == weights.size() && biasGradients.size() == biases.size());
+    assert(rows(inputs, this->inputs) * size() == gradient_cash.size());
+    auto g = gradient_cash.begin();
+    for (auto x = inputs.data(); x != inputs.data() + inputs.size(); x += this->inputs) {
+        auto w = weightGradients.data();
+        for (std::size_t j = 0; j < size(); ++j, ++g, w += this->inputs) {
+            kernel::axpy(*g, x, w, this->inputs);
+            biasGradients[j] += *g;
+        }
+    }
+}
+
+void Layer::apply(const vd_t &weightGradients, const vd_t &biasGradients, real_t rate) {
+    assert(weightGradients.size() == weights.size() && biasGradients.size() == biases.size());
+    kernel::axpy(-rate, weightGradients.data(), weights.data(), weights.size());
+    kernel::axpy(-rate, biasGradients.data(), biases.data(), biases.size());
+}
+
+void Layer::resetOptimizer(const Optimizer &optimizer) {
+    weightMoments.assign(optimizer.hasFirstMoments() ? weights.size() : 0, 0);
+    biasMoments.assign(optimizer.hasFirstMoments() ? biases.size() : 0, 0);
+    weightSquares.assign(optimizer.hasSecondMoments() ? weights.size() : 0, 0);
+    biasSquares.assign(optimizer.hasSecondMoments() ? biases.size() : 0, 0);
+}
+
+void Layer::apply(const vd_t &weightGradients, const vd_t &biasGradients, const Optimizer &optimizer,
+                  real_t rate, real_t scale, std::size_t step) {
+    assert(weightGradients.size() == weights.size() && biasGradients.size() == biases.size());
+    assert(weightMoments.size() == (optimizer.hasFirstMoments() ? weights.size() : 0));
+    assert(weightSquares.size() == (optimizer.hasSecondMoments() ? weights.size() : 0));
+    if (optimizer.getMethod() == Optimizer::Method::SGD) { return apply(weightGradients, biasGradients, rate * scale); }
+    optimizer.update(weights.data(), weightGradients.data(), weightMoments.data(), weightSquares.data(),
+                     weights.size(), rate, scale, step);
+    optimizer.update(biases.data(), biasGradients.data(), biasMoments.data(), biasSquares.data(),
+                     biases.size(), rate, scale, step);
 }
 
-vd_t HiddenLayer::calculateGradients(const vd_t &intermediateGradients) const {
-    assert(size() == intermediateGradients.size());
-    vd_t gradients(size());
-    for (std::size_t i = 0; i < size(); ++i) {
+void Layer::setParameters(const Layer &other) {
+    assert(other.inputs == inputs && other.size() == size());
+    std::copy(other.weights.begin(), other.weights.end(), weights.begin());
+    std::copy(other.biases.begin(), other.biases.end(), biases.begin());
+}
+
+void Layer::setParameters(const real_t *newWeights, const real_t *newBiases) {
+    std::copy(newWeights, newWeights + weights.size(), weights.begin());
+    std::copy(newBiases, newBiases + biases.size(), biases.begin());
+}
+
+void HiddenLayer::calculateGradients(const vd_t &intermediateGradients, vd_t &gradients) const {
+    assert(output_cash.size() == intermediateGradients.size());
+    gradients.resize(output_cash.size());
+    if (auto k = act::kernel(function)) {
+        return k->der(output_cash.data(), intermediateGradients.data(), gradients.data(), gradients.size());
+    }
+    for (std::size_t i = 0; i < gradients.size(); ++i) {
         gradients[i] = intermediateGradients[i] * function.der(output_cash[i]);
     }
-    return gradients;
 }
 
-vd_t OutputLayer::calculateGradients(const vd_t &intermediateGradients) const {
-    assert(size() == intermediateGradients.size());
-    vd_t gradients(size());
-    for (std::size_t i = 0; i < size(); ++i) {
+void OutputLayer::calculateGradients(const vd_t &intermediateGradients, vd_t &gradients) const {
+    assert(output_cash.size() == intermediateGradients.size());
+    gradients.resize(output_cash.size());
+    for (std::size_t i = 0; i < gradients.size(); ++i) {
         gradients[i] = output_cash[i] - intermediateGradients[i];
     }
-    return gradients;
 }
@@ -2,13 +2,23 @@
 // Created by Izzat on 11/28/2023.
 //
 
+#include <algorithm>
 #include <valarray>
 #include <cassert>
+#include <cmath>
+#include <limits>
 #include "nn.h"
 
 using namespace nn;
 
-double loss::sse(const vd_t &desired, const vd_t &actual) {
+namespace {
+    /**
+     * Smallest probability fed to log, so a confidently wrong output gives a large but finite loss.
+     */
+    constexpr real_t tiny = std::numeric_limits<real_t>::min();
+}
+
+real_t loss::sse(const vd_t &desired, const vd_t &actual) {
     assert(desired.size() == actual.size());
     auto acc = 0.0;
     for (auto i = desired.begin(), j = actual.begin(); i != desired.end(); ++i, ++j) {
@@ -18,8 +28,39 @@ double loss::sse(const vd_t &desired, const vd_t &actual) {
     return acc;
 }
 
-double loss::mse(const nn::vd_t &desired, const nn::vd_t &actual) {
-    auto n = static_cast<double>(desired.size());
+real_t loss::crossEntropy(const vd_t &desired, const vd_t &actual) {
+    assert(desired.size() == actual.size());
+    if (actual.size() == 1) {
+        auto d = desired[0], a = actual[0];
+        return -d * std::log(std::max(a, tiny)) - (1 - d) * std::log(std::max(1 - a, tiny));
+    }
+    real_t acc = 0;
+    for (std::size_t i = 0; i < desired.size(); ++i) {
+        if (desired[i] != 0) { acc -= desired[i] * std::log(std::max(actual[i], tiny)); }
+    }
+    return acc;
+}
+
+real_t loss::softmaxCrossEntropy(real_t *values, const real_t *desired, real_t *gradients, std::size_t n) {
+    real_t max = *std::max_element(values, values + n);
+    real_t sum = 0, dot = 0, mass = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        auto shifted = values[i] - max;
+        dot += desired[i] * shifted;
+        mass += desired[i];
+        values[i] = std::exp(shifted);
+        sum += values[i];
+    }
+    real_t scale = 1 / sum;
+    for (std::size_t i = 0; i < n; ++i) {
+        values[i] *= scale;
+        gradients[i] = values[i] - desired[i];
+    }
+    return mass * std::log(sum) - dot;
+}
+
+real_t loss::mse(const nn::vd_t &desired, const nn::vd_t &actual) {
+    auto n = static_cast<real_t>(desired.size());
     assert(n == desired.size());
     return sse(desired, actual) / n;
 }
\ No newline at end of file
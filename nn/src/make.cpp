@@ -8,21 +8,34 @@
 
 #include <random>
 #include <cassert>
+#include <cmath>
 
 using namespace nn;
 
-Neuron make::neuron(const ui_t &numInputs, double lowBound, double highBound) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+namespace {
+    /**
+     * @return The random generator of the calling thread.
+     */
+    std::mt19937 &generator() {
+        thread_local std::mt19937 gen(std::random_device{}());
+        return gen;
+    }
+}
+
+void make::seed(std::uint32_t value) {
+    generator().seed(value);
+}
+
+Neuron make::neuron(const ui_t &numInputs, real_t lowBound, real_t highBound) {
     std::uniform_real_distribution<> dist(lowBound, highBound);
 
     vd_t weights(numInputs);
-    for (auto &i: weights) { i = dist(gen); }
+    for (auto &i: weights) { i = dist(generator()); }
 
-    return Neuron(weights, dist(gen));
+    return Neuron(weights, dist(generator()));
 }
 
-vn_t make::layer(const ui_t &numInputs, const ui_t &numNeurons, double rangeFactor) {
+vn_t make::layer(const ui_t &numInputs, const ui_t &numNeurons, real_t rangeFactor) {
     assert(rangeFactor > 0);
     auto lowBound = -numNeurons / rangeFactor;
     auto highBound = numNeurons / rangeFactor;
@@ -36,19 +49,38 @@ vn_t make::layer(const ui_t &numInputs, const ui_t &numNeurons, double rangeFact
     return neurons;
 }
 
-Network make::network(const vi_t &dimensions, const vf_t &functions, loss::function_t lossFunction) {
+vn_t make::layer(const ui_t &numInputs, const ui_t &numNeurons, Init init, const act::Function &function) {
+    if (init == Init::Range) { return make::layer(numInputs, numNeurons); }
+    if (init == Init::Auto) { init = function.fun == act::relu.fun ? Init::He : Init::Xavier; }
+    auto fanIn = static_cast<real_t>(numInputs), fanOut = static_cast<real_t>(numNeurons);
+    real_t limit = init == Init::He ? std::sqrt(6 / fanIn) : std::sqrt(6 / (fanIn + fanOut));
+    std::uniform_real_distribution<> dist(-limit, limit);
+
+    vn_t neurons;
+    neurons.reserve(numNeurons);
+    for (ui_t i = 0; i < numNeurons; ++i) {
+        vd_t weights(numInputs);
+        for (auto &w: weights) { w = dist(generator()); }
+        neurons.emplace_back(std::move(weights), 0);
+    }
+    return neurons;
+}
+
+Network make::network(const vi_t &dimensions, const vf_t &functions, loss::function_t lossFunction, Init init) {
     auto n = static_cast<ui_t>(dimensions.size());
     assert(n == dimensions.size());
 
     vl_t layers;
     for (ui_t i = 1; i < n - 1; ++i) {
-        layers.emplace_back(make::layer(dimensions[i - 1], dimensions[i]), functions[i - 1]);
+        layers.emplace_back(make::layer(dimensions[i - 1], dimensions[i], init, functions[i - 1]), functions[i - 1]);
     }
 
-    OutputLayer outputLayer(make::layer(dimensions[n - 2], dimensions[n - 1]));
+    // Softmax and sigmoid outputs are scaled like a tanh layer
+    OutputLayer outputLayer(make::layer(dimensions[n - 2], dimensions[n - 1], init, act::sigmoid));
     return Network(layers, outputLayer, lossFunction);
 }
 
-Network make::network(const vi_t &dimensions, const act::Function &function, loss::function_t lossFunction) {
-    return make::network(dimensions, vf_t(dimensions.size() - 2, function), lossFunction);
+Network make::network(const vi_t &dimensions, const act::Function &function, loss::function_t lossFunction,
+                      Init init) {
+    return make::network(dimensions, vf_t(dimensions.size() - 2, function), lossFunction, init);
 }
\ No newline at end of file
@@ -0,0 +1,287 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include "model_file.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#if __has_include(<sys/mman.h>)
+#define NN_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace nn;
+
+namespace {
+    constexpr char magic[8] = "NNMODEL";
+    constexpr std::uint32_t version = 1;
+    constexpr std::uint32_t byteOrder = 0x01020304;
+    constexpr std::size_t alignment = 64;
+
+    /**
+     * Ids of the built-in activation functions, stored in the files. Only append to this table.
+     */
+    const act::Function *const activations[] = {
+            &act::step, &act::sign, &act::linear, &act::relu, &act::sigmoid, &act::tanh
+    };
+
+    /**
+     * Ids of the built-in loss functions, stored in the files. Only append to this table.
+     */
+    const loss::function_t losses[] = {loss::sse, loss::mse, loss::crossEntropy};
+
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byteOrder;
+        std::uint32_t realSize;
+        std::uint32_t layers;
+        std::uint32_t loss;
+        std::uint32_t reserved;
+    };
+
+    /**
+     * Offsets of every section of a model file, computed from the dimensions only.
+     */
+    struct Layout {
+        std::vector<std::size_t> weights;
+        std::vector<std::size_t> biases;
+        std::size_t inputMinMax = 0;
+        std::size_t outputMinMax = 0;
+        std::size_t size = 0;
+    };
+
+    std::size_t align(std::size_t offset) {
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+
+    /**
+     * Moves the offset past rows * columns values.
+     * @return False if the offset, aligned afterwards, doesn't fit in a size_t.
+     */
+    bool advance(std::size_t &offset, std::size_t rows, std::size_t columns) {
+        constexpr auto max = std::numeric_limits<std::size_t>::max();
+        if (columns != 0 && rows > max / columns) { return false; }
+        if (offset > max - alignment || rows * columns > (max - alignment - offset) / sizeof(real_t)) { return false; }
+        offset += rows * columns * sizeof(real_t);
+        return true;
+    }
+
+    /**
+     * @return The layout, or nothing if the dimensions of a corrupt file overflow the offsets.
+     */
+    std::optional<Layout> layoutOf(const std::vector<std::size_t> &dimensions) {
+        Layout layout;
+        auto layers = dimensions.size() - 1;
+        std::size_t offset = sizeof(Header) + (2 * layers) * sizeof(std::uint32_t);
+        for (std::size_t i = 0; i < layers; ++i) {
+            layout.weights.push_back(offset = align(offset));
+            if (!advance(offset, dimensions[i], dimensions[i + 1])) { return std::nullopt; }
+            layout.biases.push_back(offset = align(offset));
+            if (!advance(offset, dimensions[i + 1], 1)) { return std::nullopt; }
+        }
+        layout.inputMinMax = offset = align(offset);
+        if (!advance(offset, dimensions.front(), 2)) { return std::nullopt; }
+        layout.outputMinMax = offset = align(offset);
+        if (!advance(offset, dimensions.back(), 2)) { return std::nullopt; }
+        layout.size = offset;
+        return layout;
+    }
+
+    std::optional<std::uint32_t> idOf(const act::Function &function) {
+        for (std::uint32_t i = 0; i < std::size(activations); ++i) {
+            if (activations[i]->fun == function.fun) { return i; }
+        }
+        return std::nullopt;
+    }
+
+    std::optional<std::uint32_t> idOf(loss::function_t function) {
+        for (std::uint32_t i = 0; i < std::size(losses); ++i) {
+            if (losses[i] == function) { return i; }
+        }
+        return std::nullopt;
+    }
+
+    void writeMinMax(unsigned char *out, const vpd_t &minMax, std::size_t width) {
+        std::vector<real_t> values(2 * width);
+        for (std::size_t i = 0; i < width; ++i) {
+            values[2 * i] = minMax.empty() ? 0 : minMax[i].first;
+            values[2 * i + 1] = minMax.empty() ? 1 : minMax[i].second;
+        }
+        std::memcpy(out, values.data(), values.size() * sizeof(real_t));
+    }
+
+    vpd_t readMinMax(const unsigned char *in, std::size_t width) {
+        const auto *values = reinterpret_cast<const real_t *>(in);
+        vpd_t minMax(width);
+        for (std::size_t i = 0; i < width; ++i) { minMax[i] = {values[2 * i], values[2 * i + 1]}; }
+        return minMax;
+    }
+}
+
+std::optional<ModelFile> ModelFile::open(const std::string &path) {
+    ModelFile model;
+    std::size_t length;
+#ifdef NN_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) { return std::nullopt; }
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        close(fd);
+        return std::nullopt;
+    }
+    length = static_cast<std::size_t>(info.st_size);
+    void *mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) { return std::nullopt; }
+    model.storage.reset(static_cast<const unsigned char *>(mapped), [length](const unsigned char *p) {
+        munmap(const_cast<unsigned char *>(p), length);
+    });
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) { return std::nullopt; }
+    length = static_cast<std::size_t>(in.tellg());
+    // Allocated as real_t so the parameters are correctly aligned.
+    auto *buffer = new real_t[length / sizeof(real_t) + 1];
+    model.storage.reset(reinterpret_cast<const unsigned char *>(buffer), [](const unsigned char *p) {
+        delete[] reinterpret_cast<const real_t *>(p);
+    });
+    in.seekg(0);
+    if (!in.read(reinterpret_cast<char *>(buffer), static_cast<std::streamsize>(length))) { return std::nullopt; }
+#endif
+    if (!model.parse(length)) { return std::nullopt; }
+    return model;
+}
+
+bool ModelFile::parse(std::size_t length) {
+    const unsigned char *data = storage.get();
+    Header header{};
+    if (length < sizeof(Header)) { return false; }
+    std::memcpy(&header, data, sizeof(Header));
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version ||
+        header.byteOrder != byteOrder || header.realSize != sizeof(real_t) ||
+        header.layers < 2 || header.loss >= std::size(losses)) {
+        return false;
+    }
+
+    // Checked before allocating the table, a corrupt count would ask for gigabytes
+    std::size_t layers = header.layers;
+    if (layers > (length - sizeof(Header)) / (2 * sizeof(std::uint32_t))) { return false; }
+    std::vector<std::uint32_t> table(2 * layers);
+    std::memcpy(table.data(), data + sizeof(Header), table.size() * sizeof(std::uint32_t));
+    dimensions.assign(table.begin(), table.begin() + static_cast<std::ptrdiff_t>(layers + 1));
+    if (std::find(dimensions.begin(), dimensions.end(), 0) != dimensions.end()) { return false; }
+    for (auto i = table.begin() + static_cast<std::ptrdiff_t>(layers + 1); i != table.end(); ++i) {
+        if (*i >= std::size(activations)) { return false; }
+        functions.push_back(*activations[*i]);
+    }
+    lossFunction = losses[header.loss];
+
+    auto layout = layoutOf(dimensions);
+    if (!layout || length < layout->size) { return false; }
+    for (std::size_t i = 0; i < layers; ++i) {
+        weights.emplace_back(reinterpret_cast<const real_t *>(data + layout->weights[i]),
+                             dimensions[i] * dimensions[i + 1]);
+        biases.emplace_back(reinterpret_cast<const real_t *>(data + layout->biases[i]), dimensions[i + 1]);
+    }
+    inputMinMax = readMinMax(data + layout->inputMinMax, dimensions.front());
+    outputMinMax = readMinMax(data + layout->outputMinMax, dimensions.back());
+    return true;
+}
+
+bool ModelFile::write(const std::string &path, const Network &network,
+                      const vpd_t &inputMinMax, const vpd_t &outputMinMax) {
+    auto layers = network.getSize();
+    std::vector<std::size_t> dimensions{network.get(0).getInputSize()};
+    std::vector<std::uint32_t> table;
+    for (std::size_t i = 0; i < layers; ++i) { dimensions.push_back(network.get(i).size()); }
+    for (auto d: dimensions) { table.push_back(static_cast<std::uint32_t>(d)); }
+    for (std::size_t i = 0; i + 1 < layers; ++i) {
+        auto id = idOf(static_cast<const HiddenLayer &>(network.get(i)).getFunction());
+        if (!id) { return false; }
+        table.push_back(*id);
+    }
+    auto loss = idOf(network.getLossFunction());
+    if (!loss) { return false; }
+    assert(inputMinMax.empty() || inputMinMax.size() == dimensions.front());
+    assert(outputMinMax.empty() || outputMinMax.size() == dimensions.back());
+
+    auto layout = layoutOf(dimensions);
+    if (!layout) { return false; }
+    std::vector<unsigned char> data(layout->size);
+    Header header{{}, version, byteOrder, sizeof(real_t), static_cast<std::uint32_t>(layers), *loss, 0};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    std::memcpy(data.data(), &header, sizeof(Header));
+    std::memcpy(data.data() + sizeof(Header), table.data(), table.size() * sizeof(std::uint32_t));
+    for (std::size_t i = 0; i < layers; ++i) {
+        const Layer &layer = network.get(i);
+        std::memcpy(data.data() + layout->weights[i], layer.getWeights().data(),
+                    layer.getWeights().size() * sizeof(real_t));
+        std::memcpy(data.data() + layout->biases[i], layer.getBiases().data(), layer.size() * sizeof(real_t));
+    }
+    writeMinMax(data.data() + layout->inputMinMax, inputMinMax, dimensions.front());
+    writeMinMax(data.data() + layout->outputMinMax, outputMinMax, dimensions.back());
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(out);
+}
+
+const std::vector<std::size_t> &ModelFile::getDimensions() const {
+    return dimensions;
+}
+
+const vpd_t &ModelFile::getInputMinMax() const {
+    return inputMinMax;
+}
+
+const vpd_t &ModelFile::getOutputMinMax() const {
+    return outputMinMax;
+}
+
+Network ModelFile::toNetwork() const {
+    auto neurons = [this](std::size_t layer) {
+        auto inputs = dimensions[layer];
+        vn_t result;
+        for (std::size_t i = 0; i < biases[layer].size(); ++i) {
+            auto row = weights[layer].begin() + i * inputs;
+            result.emplace_back(vd_t(row, row + inputs), biases[layer][i]);
+        }
+        return result;
+    };
+    vl_t hidden;
+    for (std::size_t i = 0; i + 1 < weights.size(); ++i) { hidden.emplace_back(neurons(i), functions[i]); }
+    return Network(hidden, OutputLayer(neurons(weights.size() - 1)), lossFunction);
+}
+
+void ModelFile::predict(const real_t *inputs, std::size_t rows, real_t *outputs) const {
+    vd_t x(rows * dimensions.front()), y;
+    process::minmax(inputs, x.data(), x.size(), inputMinMax);
+    for (std::size_t l = 0; l < weights.size(); ++l) {
+        auto in = dimensions[l], out = dimensions[l + 1];
+        y.resize(rows * out);
+        for (std::size_t r = 0; r < rows; ++r) {
+            for (std::size_t i = 0; i < out; ++i) {
+                y[r * out + i] = kernel::dot(weights[l].data() + i * in, x.data() + r * in, in) + biases[l][i];
+            }
+        }
+        if (l + 1 < weights.size()) {
+            if (auto k = act::kernel(functions[l])) { k->fun(y.data(), y.data(), y.size()); }
+            else { std::transform(y.begin(), y.end(), y.begin(), functions[l].fun); }
+        } else if (out == 1) {
+            act::kernel(act::sigmoid)->fun(y.data(), y.data(), y.size());
+        } else {
+            for (auto o = y.data(); o != y.data() + y.size(); o += out) { act::softmax(o, out); }
+        }
+        std::swap(x, y);
+    }
+    process::inverseMinmax(x.data(), outputs, x.size(), outputMinMax);
+}
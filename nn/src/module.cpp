@@ -3,154 +3,545 @@
 //
 
 #include "module.h"
+#include "thread_pool.h"
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <mutex>
+#include <numeric>
 
 using namespace nn;
 
+namespace {
+    /**
+     * Copies the normalized rows in the range [from, to) of the epoch order into a batch buffer,
+     * reused between batches. An empty order visits the rows as they are stored.
+     */
+    void batch(const Dataset &data, const std::vector<std::size_t> &order, std::size_t from, std::size_t to,
+               vd_t &out) {
+        if (order.empty()) {
+            auto rows = data.normalized(from, to);
+            out.assign(rows.begin(), rows.end());
+            return;
+        }
+        out.clear();
+        for (std::size_t i = from; i < to; ++i) {
+            auto row = data.normalized(order[i], order[i] + 1);
+            out.insert(out.end(), row.begin(), row.end());
+        }
+    }
+
+    /**
+     * @return The class of a normalized output row, see Module::Sampling::Stratified.
+     */
+    std::size_t category(csd_t row) {
+        if (row.size() == 1) { return row[0] >= 0.5; }
+        return static_cast<std::size_t>(std::max_element(row.begin(), row.end()) - row.begin());
+    }
+
+    /**
+     * @return The range of the given worker when [from, to) is split evenly between the workers.
+     */
+    std::pair<std::size_t, std::size_t> shard(std::size_t from, std::size_t to, std::size_t worker, std::size_t workers) {
+        auto length = to - from;
+        return {from + length * worker / workers, from + length * (worker + 1) / workers};
+    }
+
+    /**
+     * @return Whether the predicted row matches the desired row, see Module::QuantizationReport.
+     */
+    bool correct(const real_t *predicted, const real_t *desired, std::size_t n) {
+        if (n == 1) { return std::abs(predicted[0] - desired[0]) < 0.5; }
+        auto p = std::max_element(predicted, predicted + n) - predicted;
+        return p == std::max_element(desired, desired + n) - desired;
+    }
+
+    /**
+     * @return The dataset, copied first if other modules share it, so it can be changed.
+     */
+    Dataset &own(std::shared_ptr<Dataset> &data) {
+        if (data.use_count() > 1) { data = std::make_shared<Dataset>(*data); }
+        return *data;
+    }
+
+    /**
+     * @return The dataset, about to be given new rows. A shared dataset is left to the other modules
+     * and replaced by an empty one with the same min-max parameters, so its rows aren't copied.
+     */
+    Dataset &replace(std::shared_ptr<Dataset> &data) {
+        if (data.use_count() > 1) {
+            auto empty = std::make_shared<Dataset>();
+            empty->setMinMax(data->getMinMax());
+            data = std::move(empty);
+        }
+        return *data;
+    }
+}
+
 Module::Module()
-        : network(), trainInput(), trainOutput(), testInput(), testOutput() {}
+        : network(), trainInput(std::make_shared<Dataset>()), trainOutput(std::make_shared<Dataset>()),
+          testInput(std::make_shared<Dataset>()), testOutput(std::make_shared<Dataset>()) {}
 
 Module::Module(nn::Network network)
-        : network(network), trainInput(), trainOutput(), testInput(), testOutput() {}
+        : network(network), optimizer(network.getOptimizer()), trainInput(std::make_shared<Dataset>()),
+          trainOutput(std::make_shared<Dataset>()), testInput(std::make_shared<Dataset>()),
+          testOutput(std::make_shared<Dataset>()) {}
 
 void Module::setNetwork(Network newNetwork) {
     this->network.emplace(std::move(newNetwork));
+    this->network->setOptimizer(optimizer);
+    std::lock_guard<std::mutex> lock(workers.mutex);
+    workers.replicas.clear();
+}
+
+void Module::setOptimizer(const Optimizer &newOptimizer) {
+    this->optimizer = newOptimizer;
+    if (network) { network->setOptimizer(optimizer); }
+}
+
+const Optimizer &Module::getOptimizer() const {
+    return optimizer;
+}
+
+const Network &Module::getNetwork() const {
+    return *network;
 }
 
 vvvd_t Module::getWeights() const {
     vvvd_t res;
     for (std::size_t i = 0; i < network->getSize(); ++i) {
+        const Layer &layer = network->get(i);
         vvd_t weights;
-        for (const Neuron &neuron: network->get(i)) {
-            weights.push_back(neuron);
+        weights.reserve(layer.size());
+        for (std::size_t j = 0; j < layer.size(); ++j) {
+            weights.push_back(layer.getWeights(j).toVector());
         }
         res.push_back(weights);
     }
     return res;
 }
 
+csd_t Module::getWeights(std::size_t layer) const {
+    const vd_t &weights = network->get(layer).getWeights();
+    return {weights.data(), weights.size()};
+}
+
+csd_t Module::getBiases(std::size_t layer) const {
+    const vd_t &biases = network->get(layer).getBiases();
+    return {biases.data(), biases.size()};
+}
+
+void Module::setParameters(std::size_t layer, const real_t *weights, const real_t *biases) {
+    network->get(layer).setParameters(weights, biases);
+}
+
 vvd_t Module::getBiases() const {
     vvd_t res;
     for (std::size_t i = 0; i < network->getSize(); ++i) {
-        vd_t biases;
-        for (const Neuron &neuron: network->get(i)) {
-            biases.push_back(neuron.getBias());
-        }
-        res.push_back(biases);
+        res.push_back(network->get(i).getBiases());
     }
     return res;
 }
 
-void Module::setLearningRate(double learningRate) {
+void Module::setLearningRate(real_t learningRate) {
     this->alpha = learningRate;
 }
 
-double Module::getLearningRate() const {
+real_t Module::getLearningRate() const {
     return alpha;
 }
 
-void Module::NormalizedData::set(const vvd_t &data) {
-    minMax.clear();
-    minMax.reserve(data[0].size());
-    for (std::size_t i = 0; i < data[0].size(); ++i) {
-        double minParam = data[0][i];
-        double maxParam = data[0][i];
-        for (std::size_t j = 1; j < data.size(); ++j) {
-            minParam = std::min(minParam, data[j][i]);
-            maxParam = std::max(maxParam, data[j][i]);
-        }
-        minMax.emplace_back(minParam, maxParam);
-    }
-    normalized = normalize(data);
+void Module::setThreads(std::size_t count) {
+    this->threads = count;
 }
 
-vvd_t Module::NormalizedData::get() const {
-    return denormalize(normalized);
+std::size_t Module::getThreads() const {
+    return threads;
 }
 
-const vvd_t &Module::NormalizedData::use() const {
-    return normalized;
+void Module::setParallelMode(ParallelMode mode) {
+    this->parallelMode = mode;
 }
 
-vvd_t Module::NormalizedData::normalize(const nn::vvd_t &original) const {
-    vvd_t norm;
-    norm.reserve(original.size());
-    for (const vd_t &data: original) {
-        norm.push_back(process::minmax(data, minMax));
-    }
-    return norm;
+Module::ParallelMode Module::getParallelMode() const {
+    return parallelMode;
 }
 
-vvd_t Module::NormalizedData::denormalize(const vvd_t &processed) const {
-    vvd_t original;
-    original.reserve(processed.size());
-    for (const vd_t &data: processed) {
-        original.push_back(process::inverseMinmax(data, minMax));
-    }
-    return original;
+void Module::setDeterministic(bool value) {
+    this->deterministic = value;
+}
+
+bool Module::isDeterministic() const {
+    return deterministic;
+}
+
+void Module::updateTestMinMax() {
+    if (testInput->getMinMax() != trainInput->getMinMax()) { own(testInput).setMinMax(trainInput->getMinMax()); }
+    if (testOutput->getMinMax() != trainOutput->getMinMax()) { own(testOutput).setMinMax(trainOutput->getMinMax()); }
+}
+
+void Module::normalizeTestData() const {
+    Profiler::Scope scope(profiler, Profiler::Phase::TestNormalization);
+    (void) testInput->normalized();
+    (void) testOutput->normalized();
 }
 
 void Module::setTrainInput(const vvd_t &data) {
-    trainInput.set(data);
+    Profiler::Scope scope(profiler, Profiler::Phase::Normalization);
+    Dataset &dataset = replace(trainInput);
+    dataset.set(data);
+    trainRows.clear();
+    testRows.clear();
+    dataset.fitMinMax();
+    (void) dataset.normalized();
+    updateTestMinMax();
+}
+
+void Module::setTrainInput(const real_t *data, std::size_t rows, std::size_t width) {
+    Profiler::Scope scope(profiler, Profiler::Phase::Normalization);
+    Dataset &dataset = replace(trainInput);
+    dataset.set(data, rows, width);
+    trainRows.clear();
+    testRows.clear();
+    dataset.fitMinMax();
+    (void) dataset.normalized();
+    updateTestMinMax();
 }
 
 [[nodiscard]] vvd_t Module::getTrainInput() const {
-    return trainInput.get();
+    return trainInput->toRows();
+}
+
+std::size_t Module::getTrainSize() const {
+    return trainInput->size();
 }
 
 void Module::setTrainOutput(const vvd_t &data) {
-    trainOutput.set(data);
+    Profiler::Scope scope(profiler, Profiler::Phase::Normalization);
+    Dataset &dataset = replace(trainOutput);
+    dataset.set(data);
+    trainRows.clear();
+    testRows.clear();
+    dataset.fitMinMax();
+    (void) dataset.normalized();
+    updateTestMinMax();
+}
+
+void Module::setTrainOutput(const real_t *data, std::size_t rows, std::size_t width) {
+    Profiler::Scope scope(profiler, Profiler::Phase::Normalization);
+    Dataset &dataset = replace(trainOutput);
+    dataset.set(data, rows, width);
+    trainRows.clear();
+    testRows.clear();
+    dataset.fitMinMax();
+    (void) dataset.normalized();
+    updateTestMinMax();
 }
 
 [[nodiscard]] vvd_t Module::getTrainOutput() const {
-    return trainOutput.get();
+    return trainOutput->toRows();
 }
 
 void Module::setTestInput(const vvd_t &data) {
-    testInput = data;
+    replace(testInput).set(data);
+}
+
+void Module::setTestInput(const real_t *data, std::size_t rows, std::size_t width) {
+    replace(testInput).set(data, rows, width);
 }
 
 [[nodiscard]] vvd_t Module::getTestInput() const {
-    return testInput;
+    return testInput->toRows();
 }
 
 void Module::setTestOutput(const vvd_t &data) {
-    testOutput = data;
+    replace(testOutput).set(data);
+}
+
+void Module::setTestOutput(const real_t *data, std::size_t rows, std::size_t width) {
+    replace(testOutput).set(data, rows, width);
 }
 
 [[nodiscard]] vvd_t Module::getTestOutput() const {
-    return testOutput;
+    return testOutput->toRows();
+}
+
+void Module::setSampling(Sampling strategy) {
+    this->sampling = strategy;
+}
+
+Module::Sampling Module::getSampling() const {
+    return sampling;
+}
+
+void Module::setSeed(std::uint32_t seed) {
+    random.seed(seed);
+}
+
+void Module::sample() {
+    // Without held out rows every stored row is trained on, and sequential epochs need no order
+    if (sampling == Sampling::Sequential) {
+        order = trainRows;
+        return;
+    }
+    auto rows = trainRows.empty() ? trainInput->size() : trainRows.size();
+    order.resize(rows);
+    if (sampling == Sampling::Bootstrap) {
+        if (rows == 0) { return; }
+        std::uniform_int_distribution<std::size_t> pick(0, rows - 1);
+        for (auto &i: order) {
+            i = pick(random);
+            if (!trainRows.empty()) { i = trainRows[i]; }
+        }
+        return;
+    }
+    if (trainRows.empty()) {
+        std::iota(order.begin(), order.end(), 0);
+    } else {
+        std::copy(trainRows.begin(), trainRows.end(), order.begin());
+    }
+    std::shuffle(order.begin(), order.end(), random);
+    if (sampling == Sampling::Shuffle) { return; }
+
+    // The k-th of the n shuffled rows of a class is placed at (k + offset) / n, the offset is drawn per class
+    std::vector<std::size_t> classes(rows), ranks(rows), counts;
+    for (std::size_t j = 0; j < rows; ++j) {
+        classes[j] = category(trainOutput->normalized(order[j], order[j] + 1));
+        if (classes[j] >= counts.size()) { counts.resize(classes[j] + 1, 0); }
+        ranks[j] = counts[classes[j]]++;
+    }
+    std::uniform_real_distribution<double> uniform(0, 1);
+    std::vector<double> offsets(counts.size());
+    for (auto &offset: offsets) { offset = uniform(random); }
+    std::vector<std::pair<double, std::size_t>> positions(rows);
+    for (std::size_t j = 0; j < rows; ++j) {
+        auto c = classes[j];
+        positions[j] = {(static_cast<double>(ranks[j]) + offsets[c]) / static_cast<double>(counts[c]), order[j]};
+    }
+    std::sort(positions.begin(), positions.end());
+    for (std::size_t j = 0; j < rows; ++j) { order[j] = positions[j].second; }
+}
+
+std::size_t Module::epochSize() const {
+    return order.empty() ? trainInput->size() : order.size();
+}
+
+void Module::setTrainRows(const std::vector<std::size_t> &rows) {
+    assert(!rows.empty());
+    assert(std::all_of(rows.begin(), rows.end(), [this](std::size_t i) { return i < trainInput->size(); }));
+    trainRows.assign(rows.begin(), rows.end());
+}
+
+void Module::holdOut(const std::vector<std::size_t> &rows) {
+    std::vector<bool> held(trainInput->size(), false);
+    for (auto i: rows) {
+        assert(i < held.size());
+        held[i] = true;
+    }
+    testRows.assign(rows.begin(), rows.end());
+    trainRows.clear();
+    for (std::size_t i = 0; i < held.size(); ++i) {
+        if (!held[i]) { trainRows.push_back(i); }
+    }
+    assert(!testRows.empty() && !trainRows.empty());
+}
+
+real_t Module::train() {
+    sample();
+    return trainSamples();
+}
+
+real_t Module::trainSamples() {
+    assert(trainInput->size() == trainOutput->size());
+
+    auto rows = epochSize();
+    real_t sum = 0;
+    vd_t x, y;
+    for (std::size_t i = 0; i < rows; ++i) {
+        batch(*trainInput, order, i, i + 1, x);
+        batch(*trainOutput, order, i, i + 1, y);
+        sum += network->train(x, y, alpha);
+    }
+    return sum / (real_t) rows;
+}
+
+real_t Module::test() const {
+    // Held out rows are tested from the training sets, the testing sets are left alone
+    bool heldOut = !testRows.empty();
+    if (!heldOut) { normalizeTestData(); }
+    const Dataset &inputs = heldOut ? *trainInput : *testInput, &targets = heldOut ? *trainOutput : *testOutput;
+    assert(inputs.size() == targets.size());
+
+    // Rows go through the network in chunks, each row's error is computed from the chunk's outputs
+    auto rows = heldOut ? testRows.size() : inputs.size(), n = targets.width();
+    real_t sum = 0;
+    Network::Workspace workspace(*network);
+    vd_t x, outputs, actual(n), desired(n);
+    for (std::size_t i = 0; i < rows; i += predictionChunk) {
+        auto end = std::min(i + predictionChunk, rows);
+        batch(targets, testRows, i, end, outputs);
+        batch(inputs, testRows, i, end, x);
+        const vd_t &predicted = network->predict(x, workspace);
+        assert(predicted.size() == outputs.size());
+        for (std::size_t j = 0; j < outputs.size(); j += n) {
+            actual.assign(predicted.begin() + j, predicted.begin() + j + n);
+            desired.assign(outputs.begin() + j, outputs.begin() + j + n);
+            sum += network->getLossFunction()(desired, actual);
+        }
+    }
+    return sum / (real_t) rows;
+}
+
+ThreadPool &Module::pool() const {
+    auto size = threads == 0 ? ThreadPool::concurrency() : threads;
+    if (!workers.pool || workers.size != size) {
+        workers.pool.reset();
+        workers.pool = std::make_unique<ThreadPool>(size);
+        workers.size = size;
+    }
+    return *workers.pool;
+}
+
+real_t Module::trainBatches(std::size_t batchSize) {
+    Profiler::Scope scope(profiler, Profiler::Phase::Epoch);
+    sample();
+    if (threads != 1) {
+        std::lock_guard<std::mutex> lock(workers.mutex);
+        return trainParallel(batchSize, pool());
+    }
+    return trainSerial(batchSize);
+}
+
+real_t Module::trainSerial(std::size_t batchSize) {
+    assert(batchSize > 0);
+    if (batchSize == 1) { return trainSamples(); }
+
+    auto rows = epochSize();
+    assert(trainInput->size() == trainOutput->size());
+
+    real_t sum = 0;
+    vd_t x, y;
+    for (std::size_t i = 0; i < rows; i += batchSize) {
+        auto end = std::min(i + batchSize, rows);
+        batch(*trainInput, order, i, end, x);
+        batch(*trainOutput, order, i, end, y);
+        sum += network->trainBatch(x, y, alpha);
+    }
+    return sum / (real_t) rows;
+}
+
+real_t Module::trainParallel(std::size_t batchSize, ThreadPool &pool) {
+    assert(batchSize > 0);
+    if (pool.size() == 1) { return trainSerial(batchSize); }
+    return parallelMode == ParallelMode::Hogwild
+           ? trainHogwild(batchSize, pool)
+           : trainSynchronous(batchSize, pool);
 }
 
-double Module::train() {
-    const vvd_t &inputs = trainInput.use();
-    const vvd_t &outputs = trainOutput.use();
-    assert(inputs.size() == outputs.size());
+void Module::prepareReplicas(std::size_t count) {
+    if (workers.replicas.size() != count) { workers.replicas.clear(); }
+    if (workers.replicas.empty()) {
+        workers.replicas.reserve(count);
+        for (std::size_t w = 0; w < count; ++w) {
+            workers.replicas.emplace_back(*network);
+            workers.replicas.back().network.getProfiler().reset();
+        }
+        workers.total.emplace(*network);
+        workers.locks = std::vector<std::mutex>(network->getSize());
+    }
+}
 
-    double sum = 0;
-    for (std::size_t i = 0; i < inputs.size(); ++i) {
-        sum += network->train(inputs[i], outputs[i], alpha);
+real_t Module::trainSynchronous(std::size_t batchSize, ThreadPool &pool) {
+    // Batches too small to share are trained on the calling thread, like single-threaded training
+    if (batchSize < 2 * minimumShard) { return trainSerial(batchSize); }
+    auto rows = epochSize();
+    assert(trainInput->size() == trainOutput->size());
+
+    prepareReplicas(pool.size());
+    auto &replicas = workers.replicas;
+    auto &total = *workers.total;
+    std::mutex mutex;
+
+    real_t sum = 0;
+    for (std::size_t i = 0; i < rows; i += batchSize) {
+        auto end = std::min(i + batchSize, rows);
+        auto active = std::max<std::size_t>(1, std::min(pool.size(), (end - i) / minimumShard));
+        total.clear();
+        auto task = [&](std::size_t w) {
+            auto &replica = replicas[w];
+            replica.loss = 0;
+            replica.gradients.clear();
+            if (w >= active) { return; }
+            auto [from, to] = shard(i, end, w, active);
+            replica.network.setParameters(*network);
+            batch(*trainInput, order, from, to, replica.inputs);
+            batch(*trainOutput, order, from, to, replica.outputs);
+            replica.loss = replica.network.accumulate(replica.inputs, replica.outputs, replica.gradients);
+            if (!deterministic) {
+                std::lock_guard<std::mutex> lock(mutex);
+                total += replica.gradients;
+            }
+        };
+        if (active == 1) {
+            task(0);
+        } else {
+            // Wrapped, so the std::function doesn't copy the task to the heap every batch
+            pool.run(std::ref(task));
+        }
+        for (std::size_t w = 0; w < active; ++w) {
+            if (deterministic) { total += replicas[w].gradients; }
+            sum += replicas[w].loss;
+        }
+        Profiler::Scope scope(network->getProfiler(), Profiler::Phase::Update);
+        network->apply(total, alpha, end - i);
     }
-    return sum / (double) inputs.size();
+    mergeProfiles();
+    return sum / (real_t) rows;
 }
 
-double Module::test() const {
-    const vvd_t &inputs = trainInput.normalize(testInput);
-    const vvd_t &outputs = trainOutput.normalize(testOutput);
-    assert(inputs.size() == outputs.size());
+real_t Module::trainHogwild(std::size_t batchSize, ThreadPool &pool) {
+    auto rows = epochSize();
+    assert(trainInput->size() == trainOutput->size());
+
+    auto workerCount = pool.size();
+    prepareReplicas(workerCount);
+    auto &replicas = workers.replicas;
+    auto &locks = workers.locks;
+    Network &shared = *network;
+    pool.run([&](std::size_t w) {
+        // Each worker keeps its own caches, reads the shared weights and writes its updates back layer by layer
+        auto &replica = replicas[w];
+        auto [from, to] = shard(0, rows, w, workerCount);
+        replica.loss = 0;
+        for (std::size_t i = from; i < to; i += batchSize) {
+            auto end = std::min(i + batchSize, to);
+            replica.network.setParameters(shared, locks);
+            replica.gradients.clear();
+            batch(*trainInput, order, i, end, replica.inputs);
+            batch(*trainOutput, order, i, end, replica.outputs);
+            replica.loss += replica.network.accumulate(replica.inputs, replica.outputs, replica.gradients);
+            Profiler::Scope scope(replica.network.getProfiler(), Profiler::Phase::Update);
+            shared.apply(replica.gradients, alpha, end - i, locks);
+        }
+    });
+    mergeProfiles();
+
+    real_t sum = 0;
+    for (const auto &replica: replicas) { sum += replica.loss; }
+    return sum / (real_t) rows;
+}
 
-    double sum = 0;
-    for (std::size_t i = 0; i < inputs.size(); ++i) {
-        sum += network->test(inputs[i], outputs[i]);
+void Module::mergeProfiles() {
+    for (auto &replica: workers.replicas) {
+        network->getProfiler() += replica.network.getProfiler();
+        replica.network.getProfiler().reset();
     }
-    return sum / (double) inputs.size();
 }
 
-vd_t Module::train(std::size_t epochs) {
+vd_t Module::train(std::size_t epochs, std::size_t batchSize) {
     vd_t errors(epochs);
-    for (std::size_t i = 0; i < epochs; ++i) { errors[i] = train(); }
+    for (std::size_t i = 0; i < epochs; ++i) { errors[i] = trainBatches(batchSize); }
     return errors;
 }
 
@@ -160,24 +551,114 @@ vd_t Module::test(std::size_t epochs) const {
     return errors;
 }
 
-vpd_t Module::trainAndTest(std::size_t epochs) {
+vpd_t Module::trainAndTest(std::size_t epochs, std::size_t batchSize) {
     vpd_t errors(epochs);
     for (std::size_t i = 0; i < epochs; ++i) {
-        errors[i].first = train();
+        errors[i].first = trainBatches(batchSize);
         errors[i].second = test();
     }
     return errors;
 }
 
 vvd_t Module::predict() const {
-    return predict(testInput);
+    vd_t outputs;
+    predict(outputs);
+    return Dataset(outputs.data(), testInput->size(), trainOutput->getMinMax().size()).toRows();
 }
 
 vvd_t Module::predict(const vvd_t &inputData) const {
-    const vvd_t &normalized = trainInput.normalize(inputData);
-    vvd_t processed(normalized.size());
-    for (std::size_t i = 0; i < processed.size(); ++i) {
-        processed[i] = network->predict(normalized[i]);
+    Dataset inputs(inputData);
+    auto width = trainOutput->getMinMax().size();
+    vd_t outputs(inputs.size() * width);
+    predict(inputs.data().data(), inputs.size(), outputs.data());
+    return Dataset(outputs.data(), inputs.size(), width).toRows();
+}
+
+void Module::predict(vd_t &outputs) const {
+    outputs.resize(testInput->size() * trainOutput->getMinMax().size());
+    predict(testInput->data().data(), testInput->size(), outputs.data());
+}
+
+void Module::predict(const real_t *inputs, std::size_t rows, real_t *outputs) const {
+    // The widths come from the min-max parameters, which are kept when a model is loaded without data
+    auto in = trainInput->getMinMax().size(), out = trainOutput->getMinMax().size();
+    auto chunks = (rows + predictionChunk - 1) / predictionChunk;
+    if (chunks == 0) { return; }
+    std::lock_guard<std::mutex> lock(workers.mutex);
+    // A single chunk or thread is predicted on the calling thread, without starting the pool
+    auto size = chunks == 1 || threads == 1 ? 1 : std::min(pool().size(), chunks);
+    while (workers.predictions.size() < size) { workers.predictions.emplace_back(*network); }
+    auto task = [&](std::size_t w) {
+        auto [from, to] = shard(0, rows, w, size);
+        auto &[workspace, x] = workers.predictions[w];
+        for (std::size_t i = from; i < to; i += predictionChunk) {
+            auto end = std::min(i + predictionChunk, to);
+            x.resize((end - i) * in);
+            trainInput->normalize(inputs + i * in, x.data(), x.size());
+            const vd_t &y = network->predict(x, workspace);
+            assert(y.size() == (end - i) * out);
+            trainOutput->denormalize(y.data(), outputs + i * out, y.size());
+        }
+    };
+    if (size == 1) {
+        task(0);
+        return;
     }
-    return trainOutput.denormalize(processed);
-}
\ No newline at end of file
+    pool().run([&](std::size_t w) { if (w < size) { task(w); } });
+}
+
+Profiler Module::getProfile() const {
+    Profiler profile = profiler;
+    if (network) { profile += network->getProfiler(); }
+    return profile;
+}
+
+void Module::resetProfile() {
+    profiler.reset();
+    if (network) { network->getProfiler().reset(); }
+}
+
+QuantizedNetwork Module::quantize() const {
+    return QuantizedNetwork(*network, trainInput->normalized());
+}
+
+Module::QuantizationReport Module::compare(const QuantizedNetwork &quantized) const {
+    QuantizationReport report{0, 0, 0};
+    if (testInput->empty()) { return report; }
+
+    const vd_t &inputs = testInput->normalized(), &outputs = testOutput->normalized();
+    vd_t expected = network->predict(inputs);
+    vd_t actual = quantized.predict(inputs);
+    assert(expected.size() == outputs.size() && actual.size() == outputs.size());
+
+    auto n = testOutput->width();
+    for (std::size_t i = 0; i < outputs.size(); i += n) {
+        report.accuracy += correct(expected.data() + i, outputs.data() + i, n);
+        report.quantizedAccuracy += correct(actual.data() + i, outputs.data() + i, n);
+    }
+    for (std::size_t i = 0; i < outputs.size(); ++i) {
+        report.maxDifference = std::max(report.maxDifference, std::abs(expected[i] - actual[i]));
+    }
+    auto rows = static_cast<real_t>(testInput->size());
+    report.accuracy /= rows;
+    report.quantizedAccuracy /= rows;
+    return report;
+}
+
+bool Module::save(const std::string &path) const {
+    return ModelFile::write(path, *network, trainInput->getMinMax(), trainOutput->getMinMax());
+}
+
+bool Module::load(const std::string &path) {
+    auto file = ModelFile::open(path);
+    if (!file) { return false; }
+    setNetwork(file->toNetwork());
+    replace(trainInput).clear();
+    replace(trainOutput).clear();
+    trainRows.clear();
+    testRows.clear();
+    trainInput->setMinMax(file->getInputMinMax());
+    trainOutput->setMinMax(file->getOutputMinMax());
+    updateTestMinMax();
+    return true;
+}
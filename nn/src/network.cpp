@@ -10,21 +10,90 @@ using namespace nn;
 
 Network::Network(vl_t layers, OutputLayer outputLayer, loss::function_t lossFunction)
         : size(layers.size() + 1), layers(std::move(layers)),
-          outputLayer(std::move(outputLayer)), lossFunction(lossFunction) {
+          outputLayer(std::move(outputLayer)), lossFunction(lossFunction), workspace(*this) {
     assert(!this->layers.empty());
     assert([this] {
         auto i = this->layers.cbegin();
         for (i = std::next(i); i != this->layers.cend(); i = std::next(i)) {
-            if (i->cbegin()->size() != std::prev(i)->size()) { return false; }
+            if (i->getInputSize() != std::prev(i)->size()) { return false; }
         }
-        return this->outputLayer.cbegin()->size() == this->layers.crbegin()->size();
+        return this->outputLayer.getInputSize() == this->layers.crbegin()->size();
     }());
 }
 
+Network::Network(const Network &other)
+        : size(other.size), layers(other.layers), outputLayer(other.outputLayer), lossFunction(other.lossFunction),
+          workspace(other.workspace), profiler(other.profiler), optimizer(other.optimizer),
+          steps(other.steps.load()), batchGradients(other.batchGradients) {}
+
+Network::Network(Network &&other) noexcept
+        : size(other.size), layers(std::move(other.layers)), outputLayer(std::move(other.outputLayer)),
+          lossFunction(other.lossFunction), workspace(std::move(other.workspace)), profiler(other.profiler),
+          optimizer(std::move(other.optimizer)), steps(other.steps.load()),
+          batchGradients(std::move(other.batchGradients)) {}
+
+Network::Workspace::Workspace(const Network &network) : errors(network.getSize()) {
+    std::size_t width = 0;
+    for (std::size_t i = 0; i < network.getSize(); ++i) {
+        const Layer &layer = network.get(i);
+        errors[i].reserve(layer.getInputSize());
+        width = std::max({width, layer.size(), layer.getInputSize()});
+    }
+    front.reserve(width);
+    back.reserve(width);
+    actual.reserve(network.outputLayer.size());
+    desired.reserve(network.outputLayer.size());
+}
+
+Network::Gradients::Gradients(const Network &network) : weights(network.getSize()), biases(network.getSize()) {
+    for (std::size_t i = 0; i < network.getSize(); ++i) {
+        weights[i].resize(network.get(i).getWeights().size());
+        biases[i].resize(network.get(i).size());
+    }
+}
+
+void Network::Gradients::clear() {
+    for (auto &w: weights) { std::fill(w.begin(), w.end(), 0); }
+    for (auto &b: biases) { std::fill(b.begin(), b.end(), 0); }
+}
+
+Network::Gradients &Network::Gradients::operator+=(const Gradients &other) {
+    assert(weights.size() == other.weights.size());
+    for (std::size_t i = 0; i < weights.size(); ++i) {
+        kernel::axpy(1, other.weights[i].data(), weights[i].data(), weights[i].size());
+        kernel::axpy(1, other.biases[i].data(), biases[i].data(), biases[i].size());
+    }
+    return *this;
+}
+
 std::size_t Network::getSize() const {
     return size;
 }
 
+loss::function_t Network::getLossFunction() const {
+    return lossFunction;
+}
+
+void Network::setOptimizer(const Optimizer &newOptimizer) {
+    optimizer = newOptimizer;
+    steps = 0;
+    for (std::size_t i = 0; i < size; ++i) { get(i).resetOptimizer(optimizer); }
+    if (optimizer.getMethod() == Optimizer::Method::SGD) { batchGradients.reset(); }
+    else { batchGradients.emplace(*this); }
+}
+
+const Optimizer &Network::getOptimizer() const {
+    return optimizer;
+}
+
+const Profiler &Network::getProfiler() const {
+    return profiler;
+}
+
+Profiler &Network::getProfiler() {
+    return profiler;
+}
+
 Layer &Network::get(std::size_t index) {
     if (index == layers.size()) { return outputLayer; }
     return layers[index];
@@ -46,43 +115,156 @@ const Layer &Network::rget(std::size_t index) const {
 }
 
 vd_t Network::predict(const vd_t &input) const {
-    auto res = input;
-    for (std::size_t i = 0; i < size; ++i) { res = get(i).activate(res); }
-    return res;
+    Workspace w(*this);
+    return predict(input, w);
+}
+
+const vd_t &Network::predict(const vd_t &input, Workspace &w) const {
+    get(0).activate(input, w.front);
+    for (std::size_t i = 1; i < size; ++i) {
+        get(i).activate(w.front, w.back);
+        std::swap(w.front, w.back);
+    }
+    return w.front;
 }
 
-vd_t Network::forwardPropagate(const vd_t &input) {
-    auto res = input;
-    for (std::size_t i = 0; i < size; ++i) { res = get(i).activateAndCache(res); }
-    return res;
+const vd_t &Network::forwardPropagate(const vd_t &input) {
+    const vd_t *res = &input;
+    for (std::size_t i = 0; i < size; ++i) { res = &get(i).activateAndCache(*res); }
+    return *res;
 }
 
 void Network::backwardPropagate(const vd_t &desired) {
-    auto res = desired;
+    outputLayer.calculateGradientsAndCash(desired);
+    propagateHiddenGradients();
+}
+
+void Network::propagateHiddenGradients() {
+    for (std::size_t i = 0; i + 1 < size; ++i) {
+        auto &errors = workspace.errors[size - 1 - i];
+        rget(i).propagateErrorBackward(errors);
+        rget(i + 1).calculateGradientsAndCash(errors);
+    }
+}
+
+real_t Network::propagate(const vd_t &inputs, const vd_t &outputs) {
+    using Phase = Profiler::Phase;
+    profiler.addSamples(Layer::rows(inputs, get(0).getInputSize()));
+    if (lossFunction != loss::crossEntropy || outputLayer.size() == 1) {
+        const vd_t *res;
+        {
+            Profiler::Scope scope(profiler, Phase::Forward);
+            res = &forwardPropagate(inputs);
+        }
+        {
+            Profiler::Scope scope(profiler, Phase::Backward);
+            backwardPropagate(outputs);
+        }
+        Profiler::Scope scope(profiler, Phase::Loss);
+        return batchLoss(*res, outputs);
+    }
+    const vd_t *res = &inputs;
+    {
+        Profiler::Scope scope(profiler, Phase::Forward);
+        for (auto &layer: layers) { res = &layer.activateAndCache(*res); }
+    }
+    real_t sum;
+    {
+        Profiler::Scope scope(profiler, Phase::Loss);
+        sum = outputLayer.activateWithCrossEntropy(*res, outputs);
+    }
+    Profiler::Scope scope(profiler, Phase::Backward);
+    propagateHiddenGradients();
+    return sum;
+}
+
+real_t Network::train(const vd_t &input, const vd_t &output, real_t alpha) {
+    return trainBatch(input, output, alpha);
+}
+
+real_t Network::trainBatch(const vd_t &inputs, const vd_t &outputs, real_t alpha) {
+    if (batchGradients) {
+        batchGradients->clear();
+        real_t loss = accumulate(inputs, outputs, *batchGradients);
+        Profiler::Scope scope(profiler, Profiler::Phase::Update);
+        apply(*batchGradients, alpha, Layer::rows(inputs, get(0).getInputSize()));
+        return loss;
+    }
+
+    real_t loss = propagate(inputs, outputs);
+
+    Profiler::Scope scope(profiler, Profiler::Phase::Update);
     for (std::size_t i = 0; i < size; ++i) {
-        rget(i).calculateGradientsAndCash(res);
-        res = rget(i).propagateErrorBackward();
+        auto &y = (i > 0 ? get(i - 1).getOutputCash() : inputs);
+        get(i).adjust(y, alpha);
     }
+
+    return loss;
 }
 
-double Network::train(const vd_t &input, const vd_t &output, double alpha) {
-    vd_t res = forwardPropagate(input);
-    backwardPropagate(output);
+real_t Network::accumulate(const vd_t &inputs, const vd_t &outputs, Gradients &gradients) {
+    real_t loss = propagate(inputs, outputs);
 
+    Profiler::Scope scope(profiler, Profiler::Phase::Update);
     for (std::size_t i = 0; i < size; ++i) {
-        auto &layer = get(i);
-        for (std::size_t j = 0; j < layer.size(); ++j) {
-            auto &neuron = layer[j];
-            auto &y = (i > 0 ? get(i - 1).getOutputCash() : input);
-            auto e = layer.getGradientCash()[j];
-            neuron.adjust(y, e, alpha);
-        }
+        auto &y = (i > 0 ? get(i - 1).getOutputCash() : inputs);
+        get(i).accumulate(y, gradients.weights[i], gradients.biases[i]);
     }
 
-    return lossFunction(res, output);
+    return loss;
+}
+
+void Network::apply(const Gradients &gradients, real_t rate) {
+    for (std::size_t i = 0; i < size; ++i) {
+        get(i).apply(gradients.weights[i], gradients.biases[i], rate);
+    }
+}
+
+void Network::apply(const Gradients &gradients, real_t alpha, std::size_t samples) {
+    assert(samples > 0);
+    auto step = ++steps;
+    real_t scale = 1 / static_cast<real_t>(samples);
+    for (std::size_t i = 0; i < size; ++i) {
+        get(i).apply(gradients.weights[i], gradients.biases[i], optimizer, alpha, scale, step);
+    }
+}
+
+void Network::apply(const Gradients &gradients, real_t alpha, std::size_t samples, std::vector<std::mutex> &locks) {
+    assert(samples > 0 && locks.size() == size);
+    auto step = ++steps;
+    real_t scale = 1 / static_cast<real_t>(samples);
+    for (std::size_t i = 0; i < size; ++i) {
+        std::lock_guard<std::mutex> lock(locks[i]);
+        get(i).apply(gradients.weights[i], gradients.biases[i], optimizer, alpha, scale, step);
+    }
+}
+
+void Network::setParameters(const Network &other) {
+    assert(other.size == size);
+    for (std::size_t i = 0; i < size; ++i) { get(i).setParameters(other.get(i)); }
+}
+
+void Network::setParameters(const Network &other, std::vector<std::mutex> &locks) {
+    assert(other.size == size && locks.size() == size);
+    for (std::size_t i = 0; i < size; ++i) {
+        std::lock_guard<std::mutex> lock(locks[i]);
+        get(i).setParameters(other.get(i));
+    }
+}
+
+real_t Network::batchLoss(const vd_t &actual, const vd_t &desired) {
+    auto n = outputLayer.size();
+    assert(actual.size() == desired.size());
+    real_t sum = 0;
+    for (auto r = actual.cbegin(), o = desired.cbegin(); r != actual.cend(); r += n, o += n) {
+        workspace.actual.assign(r, r + n);
+        workspace.desired.assign(o, o + n);
+        sum += lossFunction(workspace.desired, workspace.actual);
+    }
+    return sum;
 }
 
-double Network::test(const vd_t &input, const vd_t &output) const {
+real_t Network::test(const vd_t &input, const vd_t &output) const {
     vd_t res = predict(input);
-    return lossFunction(res, output);
+    return lossFunction(output, res);
 }
\ No newline at end of file
@@ -4,35 +4,30 @@
 
 #include "neuron.h"
 
-#include <algorithm>
-#include <numeric>
 #include <cassert>
 
 using namespace nn;
 
-Neuron::Neuron(vd_t weights, double threshold) : vd_t(std::move(weights)), bias(threshold) {}
+Neuron::Neuron(vd_t weights, real_t threshold) : vd_t(std::move(weights)), bias(threshold) {}
 
-double Neuron::getBias() const {
+real_t Neuron::getBias() const {
     return bias;
 }
 
-void Neuron::adjust(const vd_t &weightDeltas, double biasDelta) {
+void Neuron::adjust(const vd_t &weightDeltas, real_t biasDelta) {
     assert(size() == weightDeltas.size());
-    std::transform(begin(), end(), weightDeltas.begin(), begin(), std::plus<>());
+    kernel::axpy(1, weightDeltas.data(), data(), size());
     bias += biasDelta;
 }
 
-void Neuron::adjust(const vd_t &inputs, double gradient, double alpha) {
-    double factor = -1 * alpha * gradient;
-    vd_t deltas(inputs.size());
-    std::transform(inputs.begin(), inputs.end(), deltas.begin(), [factor](auto y) {
-        return y * factor;
-    });
-    auto biasDelta = factor;
-    adjust(deltas, biasDelta);
+void Neuron::adjust(const vd_t &inputs, real_t gradient, real_t alpha) {
+    assert(size() == inputs.size());
+    real_t factor = -1 * alpha * gradient;
+    kernel::axpy(factor, inputs.data(), data(), size());
+    bias += factor;
 }
 
-double Neuron::process(const vd_t &inputs) const {
+real_t Neuron::process(const vd_t &inputs) const {
     assert(size() == inputs.size());
-    return std::inner_product(begin(), end(), inputs.begin(), 0.0) + bias;
+    return kernel::dot(data(), inputs.data(), size()) + bias;
 }
\ No newline at end of file
@@ -0,0 +1,82 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include "optimizer.h"
+
+#include <cmath>
+
+using namespace nn;
+
+Optimizer::Optimizer(Method method, real_t beta1, real_t beta2, real_t epsilon)
+        : method(method), beta1(beta1), beta2(beta2), epsilon(epsilon) {}
+
+Optimizer Optimizer::sgd() {
+    return Optimizer(Method::SGD);
+}
+
+Optimizer Optimizer::momentum(real_t momentum, bool nesterov) {
+    return Optimizer(nesterov ? Method::Nesterov : Method::Momentum, momentum);
+}
+
+Optimizer Optimizer::rmsprop(real_t decay, real_t epsilon) {
+    return Optimizer(Method::RMSProp, 0, decay, epsilon);
+}
+
+Optimizer Optimizer::adam(real_t beta1, real_t beta2, real_t epsilon) {
+    return Optimizer(Method::Adam, beta1, beta2, epsilon);
+}
+
+Optimizer::Method Optimizer::getMethod() const {
+    return method;
+}
+
+bool Optimizer::hasFirstMoments() const {
+    return method == Method::Momentum || method == Method::Nesterov || method == Method::Adam;
+}
+
+bool Optimizer::hasSecondMoments() const {
+    return method == Method::RMSProp || method == Method::Adam;
+}
+
+void Optimizer::update(real_t *parameters, const real_t *gradients, real_t *first, real_t *second, std::size_t n,
+                       real_t rate, real_t scale, std::size_t step) const {
+    switch (method) {
+        case Method::SGD:
+            for (std::size_t i = 0; i < n; ++i) { parameters[i] -= rate * scale * gradients[i]; }
+            break;
+        case Method::Momentum:
+            for (std::size_t i = 0; i < n; ++i) {
+                first[i] = beta1 * first[i] + scale * gradients[i];
+                parameters[i] -= rate * first[i];
+            }
+            break;
+        case Method::Nesterov:
+            for (std::size_t i = 0; i < n; ++i) {
+                real_t g = scale * gradients[i];
+                first[i] = beta1 * first[i] + g;
+                parameters[i] -= rate * (g + beta1 * first[i]);
+            }
+            break;
+        case Method::RMSProp:
+            for (std::size_t i = 0; i < n; ++i) {
+                real_t g = scale * gradients[i];
+                second[i] = beta2 * second[i] + (1 - beta2) * g * g;
+                parameters[i] -= rate * g / (std::sqrt(second[i]) + epsilon);
+            }
+            break;
+        case Method::Adam: {
+            auto t = static_cast<real_t>(step);
+            real_t firstCorrection = 1 / (1 - std::pow(beta1, t));
+            real_t secondCorrection = 1 / (1 - std::pow(beta2, t));
+            for (std::size_t i = 0; i < n; ++i) {
+                real_t g = scale * gradients[i];
+                first[i] = beta1 * first[i] + (1 - beta1) * g;
+                second[i] = beta2 * second[i] + (1 - beta2) * g * g;
+                parameters[i] -= rate * first[i] * firstCorrection
+                                 / (std::sqrt(second[i] * secondCorrection) + epsilon);
+            }
+            break;
+        }
+    }
+}
@@ -10,20 +10,37 @@ using namespace nn;
 vd_t process::minmax(const vd_t &data, const vpd_t &minMaxParams) {
     assert(data.size() == minMaxParams.size());
     vd_t normalized(data.size());
-    for (std::size_t i = 0; i < data.size(); ++i) {
-        auto [minParam, maxParam] = minMaxParams[i];
-        if (minParam == maxParam) { normalized[i] = 0.5; }
-        else normalized[i] = (data[i] - minParam) / (maxParam - minParam);
-    }
+    minmax(data.data(), normalized.data(), data.size(), minMaxParams);
     return normalized;
 }
 
+void process::minmax(const real_t *data, real_t *out, std::size_t n, const vpd_t &minMaxParams) {
+    auto width = minMaxParams.size();
+    assert(width > 0 && n % width == 0);
+    for (std::size_t row = 0; row < n; row += width) {
+        for (std::size_t j = 0; j < width; ++j) {
+            auto [minParam, maxParam] = minMaxParams[j];
+            auto i = row + j;
+            if (minParam == maxParam) { out[i] = 0.5; }
+            else out[i] = (data[i] - minParam) / (maxParam - minParam);
+        }
+    }
+}
+
 vd_t process::inverseMinmax(const vd_t &data, const vpd_t &minMaxParams) {
     assert(data.size() == minMaxParams.size());
     vd_t denormalized(data.size());
-    for (std::size_t i = 0; i < data.size(); ++i) {
-        auto [minParam, maxParam] = minMaxParams[i];
-        denormalized[i] = data[i] * (maxParam - minParam) + minParam;
-    }
+    inverseMinmax(data.data(), denormalized.data(), data.size(), minMaxParams);
     return denormalized;
+}
+
+void process::inverseMinmax(const real_t *data, real_t *out, std::size_t n, const vpd_t &minMaxParams) {
+    auto width = minMaxParams.size();
+    assert(width > 0 && n % width == 0);
+    for (std::size_t row = 0; row < n; row += width) {
+        for (std::size_t j = 0; j < width; ++j) {
+            auto [minParam, maxParam] = minMaxParams[j];
+            out[row + j] = data[row + j] * (maxParam - minParam) + minParam;
+        }
+    }
 }
\ No newline at end of file
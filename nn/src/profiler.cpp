@@ -0,0 +1,90 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include "profiler.h"
+
+using namespace nn;
+
+#ifdef NN_PROFILING
+namespace {
+    thread_local std::uint64_t allocationCount = 0;
+}
+
+Profiler::Scope::Scope(Profiler &profiler, Phase phase)
+        : profiler(profiler), phase(phase), start(std::chrono::steady_clock::now()), allocations(allocationCount) {}
+
+Profiler::Scope::~Scope() {
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    auto i = static_cast<std::size_t>(phase);
+    profiler.nanoseconds[i] += static_cast<std::uint64_t>(std::chrono::nanoseconds(elapsed).count());
+    profiler.allocations[i] += allocationCount - allocations;
+}
+
+void Profiler::reset() {
+    nanoseconds.fill(0);
+    allocations.fill(0);
+    samples = 0;
+}
+
+Profiler &Profiler::operator+=(const Profiler &other) {
+    for (std::size_t i = 0; i < phases; ++i) {
+        nanoseconds[i] += other.nanoseconds[i];
+        allocations[i] += other.allocations[i];
+    }
+    samples += other.samples;
+    return *this;
+}
+
+real_t Profiler::getSeconds(Phase phase) const {
+    return static_cast<real_t>(static_cast<double>(nanoseconds[static_cast<std::size_t>(phase)]) * 1e-9);
+}
+
+std::size_t Profiler::getAllocations(Phase phase) const {
+    return allocations[static_cast<std::size_t>(phase)];
+}
+
+std::size_t Profiler::getSamples() const {
+    return samples;
+}
+
+std::uint64_t Profiler::threadAllocations() {
+    return allocationCount;
+}
+
+void Profiler::countAllocation() {
+    ++allocationCount;
+}
+#else
+void Profiler::reset() {}
+
+Profiler &Profiler::operator+=(const Profiler &) {
+    return *this;
+}
+
+real_t Profiler::getSeconds(Phase) const {
+    return 0;
+}
+
+std::size_t Profiler::getAllocations(Phase) const {
+    return 0;
+}
+
+std::size_t Profiler::getSamples() const {
+    return 0;
+}
+
+std::uint64_t Profiler::threadAllocations() {
+    return 0;
+}
+
+void Profiler::countAllocation() {}
+#endif
+
+real_t Profiler::getSamplesPerSecond() const {
+    real_t seconds = getSeconds(Phase::Epoch);
+    if (seconds == 0) {
+        for (auto phase: {Phase::Forward, Phase::Loss, Phase::Backward, Phase::Update}) { seconds += getSeconds(phase); }
+    }
+    return seconds > 0 ? static_cast<real_t>(getSamples()) / seconds : 0;
+}
@@ -0,0 +1,118 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include "quantized_network.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using namespace nn;
+
+namespace {
+    constexpr real_t levels = 127;
+
+    /**
+     * @return The scale mapping the largest magnitude of the values onto the int8 range.
+     */
+    real_t scaleOf(const real_t *values, std::size_t n) {
+        real_t max = 0;
+        for (std::size_t i = 0; i < n; ++i) { max = std::max(max, std::abs(values[i])); }
+        return max > 0 ? max / levels : 1;
+    }
+
+    void quantize(const real_t *values, std::int8_t *out, std::size_t n, real_t scale) {
+        real_t factor = 1 / scale;
+        for (std::size_t i = 0; i < n; ++i) {
+            real_t q = std::round(values[i] * factor);
+            out[i] = static_cast<std::int8_t>(std::clamp(q, -levels, levels));
+        }
+    }
+
+    std::int32_t dot(const std::int8_t *a, const std::int8_t *b, std::size_t n) {
+        std::int32_t sum = 0;
+        for (std::size_t i = 0; i < n; ++i) { sum += std::int32_t(a[i]) * std::int32_t(b[i]); }
+        return sum;
+    }
+}
+
+QuantizedNetwork::QuantizedNetwork(const Network &network, const vd_t &calibration) {
+    vd_t x = calibration, y;
+    layers.reserve(network.getSize());
+    for (std::size_t i = 0; i < network.getSize(); ++i) {
+        const Layer &layer = network.get(i);
+        bool last = i + 1 == network.getSize();
+        Dense dense{layer.getInputSize(), std::vector<std::int8_t>(layer.getWeights().size()),
+                    layer.getBiases(), vd_t(layer.size()), scaleOf(x.data(), x.size()),
+                    last ? act::linear : static_cast<const HiddenLayer &>(layer).getFunction()};
+        for (std::size_t j = 0; j < layer.size(); ++j) {
+            auto w = layer.getWeights(j);
+            dense.weightScales[j] = scaleOf(w.data(), w.size());
+            quantize(w.data(), dense.weights.data() + j * dense.inputs, w.size(), dense.weightScales[j]);
+        }
+        layers.push_back(std::move(dense));
+
+        if (last) { break; }
+        layer.activate(x, y);
+        std::swap(x, y);
+    }
+}
+
+std::size_t QuantizedNetwork::getSize() const {
+    return layers.size();
+}
+
+std::size_t QuantizedNetwork::getParameterBytes() const {
+    std::size_t bytes = 0;
+    for (const auto &layer: layers) {
+        bytes += layer.weights.size() * sizeof(std::int8_t);
+        bytes += (layer.biases.size() + layer.weightScales.size() + 1) * sizeof(real_t);
+    }
+    return bytes;
+}
+
+void QuantizedNetwork::activate(const Dense &layer, const vd_t &inputs, vd_t &outputs,
+                                std::vector<std::int8_t> &quantized, bool last) {
+    auto size = layer.biases.size();
+    auto rows = Layer::rows(inputs, layer.inputs);
+    quantized.resize(inputs.size());
+    quantize(inputs.data(), quantized.data(), inputs.size(), layer.inputScale);
+
+    outputs.resize(rows * size);
+    auto r = outputs.begin();
+    for (auto x = quantized.data(); r != outputs.end(); x += layer.inputs) {
+        auto w = layer.weights.data();
+        for (std::size_t i = 0; i < size; ++i, ++r, w += layer.inputs) {
+            *r = static_cast<real_t>(dot(w, x, layer.inputs)) * layer.weightScales[i] * layer.inputScale + layer.biases[i];
+        }
+    }
+
+    if (!last) {
+        if (auto k = act::kernel(layer.function)) { return k->fun(outputs.data(), outputs.data(), outputs.size()); }
+        std::transform(outputs.begin(), outputs.end(), outputs.begin(), layer.function.fun);
+    } else if (size == 1) {
+        act::kernel(act::sigmoid)->fun(outputs.data(), outputs.data(), outputs.size());
+    } else {
+        for (auto o = outputs.data(); o != outputs.data() + outputs.size(); o += size) { act::softmax(o, size); }
+    }
+}
+
+vd_t QuantizedNetwork::predict(const vd_t &inputs) const {
+    vd_t outputs, buffer;
+    std::vector<std::int8_t> quantized;
+    predict(inputs, outputs, buffer, quantized);
+    return outputs;
+}
+
+void QuantizedNetwork::predict(const vd_t &inputs, vd_t &outputs, vd_t &buffer,
+                               std::vector<std::int8_t> &quantized) const {
+    assert(!layers.empty());
+    const vd_t *x = &inputs;
+    for (std::size_t i = 0; i < layers.size(); ++i) {
+        // Alternate between the buffers so the output layer writes into outputs.
+        vd_t &y = (layers.size() - i) % 2 == 1 ? outputs : buffer;
+        activate(layers[i], *x, y, quantized, i + 1 == layers.size());
+        x = &y;
+    }
+}
@@ -0,0 +1,121 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include "sweep.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <random>
+
+using namespace nn;
+
+Sweep::Sweep(const Module &module) : base(module), testing(!module.getTestInput().empty()) {
+    // The copies of the base share its normalized rows, which must be ready before they test concurrently
+    base.normalizeTestData();
+}
+
+void Sweep::setThreads(std::size_t count) {
+    this->threads = count;
+}
+
+std::size_t Sweep::getThreads() const {
+    return threads;
+}
+
+void Sweep::setBatchSize(std::size_t size) {
+    assert(size > 0);
+    this->batchSize = size;
+}
+
+std::size_t Sweep::getBatchSize() const {
+    return batchSize;
+}
+
+void Sweep::setSeed(std::uint32_t value) {
+    this->seed = value;
+}
+
+std::uint32_t Sweep::getSeed() const {
+    return seed;
+}
+
+std::vector<Sweep::Configuration> Sweep::grid(const Space &space) {
+    std::vector<Configuration> configurations;
+    for (const vi_t &dimensions: space.dimensions) {
+        for (const act::Function &activation: space.activations) {
+            for (loss::function_t loss: space.losses) {
+                for (real_t learningRate: space.learningRates) {
+                    for (std::size_t epochs: space.epochs) {
+                        configurations.push_back({dimensions, activation, loss, learningRate, epochs});
+                    }
+                }
+            }
+        }
+    }
+    return configurations;
+}
+
+std::vector<Sweep::Configuration> Sweep::random(const Space &space, std::size_t count, std::uint32_t seed) {
+    assert(!space.dimensions.empty() && !space.activations.empty() && !space.losses.empty()
+           && !space.learningRates.empty() && !space.epochs.empty());
+    std::mt19937 generator(seed);
+    auto pick = [&generator](const auto &candidates) {
+        std::uniform_int_distribution<std::size_t> index(0, candidates.size() - 1);
+        return candidates[index(generator)];
+    };
+    auto [low, high] = std::minmax_element(space.learningRates.begin(), space.learningRates.end());
+    std::uniform_real_distribution<real_t> exponent(std::log(*low), std::log(*high));
+
+    std::vector<Configuration> configurations;
+    configurations.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        Configuration configuration;
+        configuration.dimensions = pick(space.dimensions);
+        configuration.activation = pick(space.activations);
+        configuration.loss = pick(space.losses);
+        configuration.learningRate = *low == *high ? *low : std::exp(exponent(generator));
+        configuration.epochs = pick(space.epochs);
+        configurations.push_back(configuration);
+    }
+    return configurations;
+}
+
+std::vector<Sweep::Result> Sweep::run(const std::vector<Configuration> &configurations) const {
+    std::vector<Result> results(configurations.size());
+    std::atomic<std::size_t> next{0};
+
+    ThreadPool pool(threads);
+    pool.run([&](std::size_t) {
+        for (auto i = next++; i < configurations.size(); i = next++) {
+            const Configuration &configuration = configurations[i];
+            auto start = std::chrono::steady_clock::now();
+
+            Module module = base;
+            module.setThreads(1);
+            module.setLearningRate(configuration.learningRate);
+            make::seed(seed + static_cast<std::uint32_t>(i));
+            module.setNetwork(make::network(configuration.dimensions, configuration.activation, configuration.loss));
+            vd_t errors = module.train(configuration.epochs, batchSize);
+
+            Result &result = results[i];
+            result.configuration = configuration;
+            result.trainError = errors.empty() ? std::numeric_limits<real_t>::quiet_NaN() : errors.back();
+            result.testError = testing ? module.test() : std::numeric_limits<real_t>::quiet_NaN();
+            result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+    });
+
+    auto error = [this](const Result &result) { return testing ? result.testError : result.trainError; };
+    std::stable_sort(results.begin(), results.end(), [&error](const Result &a, const Result &b) {
+        // Diverged trainings end with NaN errors and go last
+        if (std::isnan(error(b))) { return !std::isnan(error(a)); }
+        return error(a) < error(b);
+    });
+    return results;
+}
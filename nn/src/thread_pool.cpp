@@ -0,0 +1,95 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+// WebAssembly builds only get threads when compiled with emscripten pthreads
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define NN_NO_THREADS
+#endif
+
+using namespace nn;
+
+ThreadPool::ThreadPool(std::size_t size) {
+    if (size == 0) { size = concurrency(); }
+#ifdef NN_NO_THREADS
+    size = 1;
+#endif
+    threads.reserve(size - 1);
+    for (std::size_t i = 1; i < size; ++i) {
+        threads.emplace_back(&ThreadPool::work, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto &thread: threads) { thread.join(); }
+}
+
+std::size_t ThreadPool::size() const {
+    return threads.size() + 1;
+}
+
+std::size_t ThreadPool::concurrency() {
+#ifdef NN_NO_THREADS
+    return 1;
+#else
+    return std::max(1u, std::thread::hardware_concurrency());
+#endif
+}
+
+void ThreadPool::run(const std::function<void(std::size_t)> &f) {
+    if (threads.empty()) { return f(0); }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        task = &f;
+        remaining = threads.size();
+        error = nullptr;
+        ++generation;
+    }
+    wake.notify_all();
+    std::exception_ptr caller;
+    try {
+        f(0);
+    } catch (...) {
+        caller = std::current_exception();
+    }
+    // The workers hold on to the task until they're all done, even when the caller's part failed
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return remaining == 0; });
+    if (!caller) { caller = std::exchange(error, nullptr); }
+    if (caller) { std::rethrow_exception(caller); }
+}
+
+void ThreadPool::work(std::size_t index) {
+    std::size_t seen = 0;
+    while (true) {
+        const std::function<void(std::size_t)> *current;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this, seen] { return stopping || generation != seen; });
+            if (stopping) { return; }
+            seen = generation;
+            current = task;
+        }
+        std::exception_ptr thrown;
+        try {
+            (*current)(index);
+        } catch (...) {
+            thrown = std::current_exception();
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (thrown && !error) { error = thrown; }
+            if (--remaining == 0) { done.notify_one(); }
+        }
+    }
+}
@@ -0,0 +1,224 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#ifndef FRUIT_CLASSIFIER_WASM_STATIC_NETWORK_H
+#define FRUIT_CLASSIFIER_WASM_STATIC_NETWORK_H
+
+#include "nn.h"
+#include "network.h"
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+struct nn::act::Linear {
+    static real_t fun(real_t x) { return x; }
+
+    static const Function &function() { return linear; }
+};
+
+struct nn::act::Relu {
+    static real_t fun(real_t x) { return x > 0 ? x : 0; }
+
+    static const Function &function() { return relu; }
+};
+
+struct nn::act::Sigmoid {
+    static real_t fun(real_t x) { return 1 / (1 + std::exp(-x)); }
+
+    static const Function &function() { return sigmoid; }
+};
+
+struct nn::act::Tanh {
+    static real_t fun(real_t x) { return std::tanh(x); }
+
+    static const Function &function() { return tanh; }
+};
+
+/**
+ * The first dimension is the number of inputs, the last one the number of outputs,
+ * and every dimension in between is a hidden layer using the Activation policy.
+ * The output layer behaves like OutputLayer: softmax, or sigmoid for a single output.
+ * Every product is expanded over compile-time index sequences, so the loops are fully unrolled.
+ * Meant for tiny models, code size grows with the number of weights.
+ */
+template<typename Activation, std::size_t... Dimensions>
+class nn::BasicStaticNetwork {
+public:
+    static constexpr std::size_t depth = sizeof...(Dimensions) - 1;
+    static constexpr std::array<std::size_t, sizeof...(Dimensions)> dimensions{Dimensions...};
+    static constexpr std::size_t inputs = dimensions.front();
+    static constexpr std::size_t outputs = dimensions.back();
+
+    static_assert(depth >= 2, "A static network needs at least one hidden layer");
+    static_assert(((Dimensions > 0) && ...), "Every dimension must be positive");
+
+    using input_t = std::array<real_t, inputs>;
+    using output_t = std::array<real_t, outputs>;
+
+private:
+    /**
+     * Parameters of one fully connected layer, weights are stored row-major like Layer.
+     */
+    template<std::size_t In, std::size_t Out>
+    struct Dense {
+        std::array<real_t, In * Out> weights{};
+        std::array<real_t, Out> biases{};
+    };
+
+    template<std::size_t... I>
+    static auto layersOf(std::index_sequence<I...>) -> std::tuple<Dense<dimensions[I], dimensions[I + 1]>...>;
+
+    using layers_t = decltype(layersOf(std::make_index_sequence<depth>{}));
+
+    static constexpr std::size_t width = [] {
+        std::size_t w = 0;
+        for (auto d: dimensions) { w = d > w ? d : w; }
+        return w;
+    }();
+
+    layers_t layers;
+
+    template<std::size_t In, std::size_t Out, std::size_t... I>
+    static real_t weightedSum(const Dense<In, Out> &layer, std::size_t row, const real_t *x,
+                              std::index_sequence<I...>) {
+        const real_t *w = layer.weights.data() + row * In;
+        return layer.biases[row] + (... + (w[I] * x[I]));
+    }
+
+    template<bool Hidden, std::size_t In, std::size_t Out, std::size_t... O>
+    static void process(const Dense<In, Out> &layer, const real_t *x, real_t *y, std::index_sequence<O...>) {
+        if constexpr (Hidden) {
+            ((y[O] = Activation::fun(weightedSum(layer, O, x, std::make_index_sequence<In>{}))), ...);
+        } else {
+            ((y[O] = weightedSum(layer, O, x, std::make_index_sequence<In>{})), ...);
+        }
+    }
+
+    template<std::size_t L = 0>
+    void forward(const real_t *x, real_t *front, real_t *back, real_t *output) const {
+        constexpr std::size_t out = dimensions[L + 1];
+        if constexpr (L + 1 < depth) {
+            process<true>(std::get<L>(layers), x, front, std::make_index_sequence<out>{});
+            forward<L + 1>(front, back, front, output);
+        } else {
+            process<false>(std::get<L>(layers), x, output, std::make_index_sequence<out>{});
+            if constexpr (out == 1) {
+                output[0] = act::Sigmoid::fun(output[0]);
+            } else {
+                act::softmax(output, out);
+            }
+        }
+    }
+
+    /**
+     * @return Whether layer L and the layers after it have the shapes of the static network,
+     * and whether the hidden ones use the function of the Activation policy.
+     */
+    template<std::size_t L = 0>
+    static bool matches(const Network &network) {
+        const Layer &source = network.get(L);
+        if (source.getInputSize() != dimensions[L] || source.size() != dimensions[L + 1]) { return false; }
+        if constexpr (L + 1 < depth) {
+            return static_cast<const HiddenLayer &>(source).getFunction().fun == Activation::function().fun
+                   && matches<L + 1>(network);
+        } else {
+            return true;
+        }
+    }
+
+    template<std::size_t L = 0>
+    void copyFrom(const Network &network) {
+        auto &layer = std::get<L>(layers);
+        const Layer &source = network.get(L);
+        std::copy(source.getWeights().begin(), source.getWeights().end(), layer.weights.begin());
+        std::copy(source.getBiases().begin(), source.getBiases().end(), layer.biases.begin());
+        if constexpr (L + 1 < depth) { copyFrom<L + 1>(network); }
+    }
+
+    template<std::size_t L>
+    [[nodiscard]] vn_t neurons() const {
+        const auto &layer = std::get<L>(layers);
+        constexpr std::size_t in = dimensions[L];
+        vn_t result;
+        result.reserve(dimensions[L + 1]);
+        for (std::size_t i = 0; i < dimensions[L + 1]; ++i) {
+            auto row = layer.weights.cbegin() + static_cast<std::ptrdiff_t>(i * in);
+            result.emplace_back(vd_t(row, row + in), layer.biases[i]);
+        }
+        return result;
+    }
+
+    template<std::size_t... L>
+    [[nodiscard]] vl_t hiddenLayers(std::index_sequence<L...>) const {
+        return {HiddenLayer(neurons<L>(), Activation::function())...};
+    }
+
+public:
+    /**
+     * Constructs a static network with all weights and biases set to zero.
+     */
+    BasicStaticNetwork() = default;
+
+    /**
+     * Copies the weights and biases of a dynamic network with the same dimensions.
+     * The hidden layers of the given network must use the function of the Activation policy.
+     *
+     * @param network The network to copy the parameters from.
+     * @throws std::invalid_argument If the dimensions or the hidden activation function differ.
+     */
+    explicit BasicStaticNetwork(const Network &network) {
+        if (network.getSize() != depth || !matches(network)) {
+            throw std::invalid_argument("The network doesn't match the static network");
+        }
+        copyFrom(network);
+    }
+
+    /**
+     * Builds a dynamic network holding a copy of the parameters, to be trained or used by a Module.
+     *
+     * @param lossFunction The loss function used in backpropagation.
+     * @return A dynamic network with the same dimensions, functions and parameters.
+     */
+    [[nodiscard]] Network toNetwork(loss::function_t lossFunction = loss::sse) const {
+        return Network(hiddenLayers(std::make_index_sequence<depth - 1>{}),
+                       OutputLayer(neurons<depth - 1>()), lossFunction);
+    }
+
+    /**
+     * @return The dynamic network built by toNetwork with the default loss function.
+     */
+    explicit operator Network() const {
+        return toNetwork();
+    }
+
+    /**
+     * Makes predictions based on input data without allocating memory.
+     * Intermediate results are kept in stack buffers, the object is never modified,
+     * so several threads can predict at once.
+     *
+     * @param input Pointer to the input values.
+     * @param output Pointer to the buffer receiving the predicted values.
+     */
+    void predict(const real_t *input, real_t *output) const {
+        std::array<real_t, width> front, back;
+        forward(input, front.data(), back.data(), output);
+    }
+
+    /**
+     * Makes predictions based on input data without allocating memory.
+     *
+     * @param input Array of input values.
+     * @return Array of predicted values.
+     */
+    [[nodiscard]] output_t predict(const input_t &input) const {
+        output_t output;
+        predict(input.data(), output.data());
+        return output;
+    }
+};
+
+#endif //FRUIT_CLASSIFIER_WASM_STATIC_NETWORK_H
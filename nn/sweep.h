@@ -0,0 +1,139 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#ifndef FRUIT_CLASSIFIER_WASM_SWEEP_H
+#define FRUIT_CLASSIFIER_WASM_SWEEP_H
+
+#include <cstdint>
+#include "nn.h"
+#include "module.h"
+
+/**
+ * Every configuration is trained on its own copy of a base module, which carries the data and the
+ * settings shared by all configurations: optimizer, sampling and seed. The copies share the base's
+ * data, so the training and testing sets are held in memory once however many configurations run.
+ *
+ * Configurations are handed to the workers one at a time as they finish their previous one, so
+ * large and small networks keep all the workers busy. Each copy trains on a single thread.
+ * The generators of the workers are reseeded for every configuration, see `setSeed`.
+ */
+class nn::Sweep {
+public:
+    /**
+     * The settings of one trained network.
+     */
+    struct Configuration {
+        /**
+         * Network dimensions, the number of inputs first.
+         */
+        vi_t dimensions;
+        /**
+         * Activation function of the hidden layers.
+         */
+        act::Function activation = act::tanh;
+        loss::function_t loss = loss::sse;
+        real_t learningRate = 0.01;
+        std::size_t epochs = 100;
+    };
+
+    /**
+     * The candidate values of every setting, searched by `grid` and `random`.
+     */
+    struct Space {
+        std::vector<vi_t> dimensions;
+        vf_t activations = {act::tanh};
+        std::vector<loss::function_t> losses = {loss::sse};
+        vd_t learningRates = {0.01};
+        std::vector<std::size_t> epochs = {100};
+    };
+
+    /**
+     * A trained configuration and its errors, one row of the leaderboard.
+     */
+    struct Result {
+        Configuration configuration;
+        /**
+         * Average training error of the last epoch.
+         */
+        real_t trainError;
+        /**
+         * Average testing error after the last epoch, NaN when the base module has no testing data.
+         */
+        real_t testError;
+        /**
+         * Wall time spent building, training and testing the network.
+         */
+        double seconds;
+    };
+
+private:
+    Module base;
+    bool testing;
+    std::size_t threads = 0;
+    std::size_t batchSize = 1;
+    std::uint32_t seed = 0;
+
+public:
+    /**
+     * Constructs a sweep over copies of a module.
+     * @param module The module holding the training and testing data and the shared settings.
+     * Its network, learning rate and threads are replaced in every copy.
+     */
+    explicit Sweep(const Module &module);
+
+    /**
+     * Sets the number of configurations trained at the same time.
+     * @param count The number of workers. Zero means one worker per hardware thread, the default.
+     */
+    void setThreads(std::size_t count);
+
+    [[nodiscard]] std::size_t getThreads() const;
+
+    /**
+     * Sets the batch size of every training.
+     * @param size The number of samples in each batch. Default is 1.
+     */
+    void setBatchSize(std::size_t size);
+
+    [[nodiscard]] std::size_t getBatchSize() const;
+
+    /**
+     * Sets the seed of the initial weights. Configuration i starts from the weights drawn after
+     * `make::seed(seed + i)`, so runs are reproducible whatever the number of workers. Default is 0.
+     * @param value The seed of the initial weights.
+     */
+    void setSeed(std::uint32_t value);
+
+    [[nodiscard]] std::uint32_t getSeed() const;
+
+    /**
+     * @param space The candidate values.
+     * @return Every combination of the candidate values.
+     */
+    [[nodiscard]] static std::vector<Configuration> grid(const Space &space);
+
+    /**
+     * Draws configurations at random from the space. The learning rate is drawn on a log scale
+     * between the smallest and the largest candidate, other settings from their candidates.
+     *
+     * @param space The candidate values.
+     * @param count The number of configurations.
+     * @param seed The seed of the random generator.
+     * @return The configurations, the same ones for the same seed.
+     */
+    [[nodiscard]] static std::vector<Configuration> random(const Space &space, std::size_t count,
+                                                           std::uint32_t seed);
+
+    /**
+     * Trains and tests every configuration, using all the workers.
+     * The dimensions of every configuration must match the widths of the data.
+     *
+     * @param configurations The configurations to be trained.
+     * @return The leaderboard: one result per configuration, the lowest testing error first,
+     * or the lowest training error when there's no testing data.
+     */
+    [[nodiscard]] std::vector<Result> run(const std::vector<Configuration> &configurations) const;
+};
+
+#endif //FRUIT_CLASSIFIER_WASM_SWEEP_H
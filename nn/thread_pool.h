@@ -0,0 +1,72 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#ifndef FRUIT_CLASSIFIER_WASM_THREAD_POOL_H
+#define FRUIT_CLASSIFIER_WASM_THREAD_POOL_H
+
+#include "nn.h"
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+class nn::ThreadPool {
+private:
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const std::function<void(std::size_t)> *task = nullptr;
+    std::size_t generation = 0;
+    std::size_t remaining = 0;
+    /**
+     * The first exception thrown by a worker during the current run.
+     */
+    std::exception_ptr error;
+    bool stopping = false;
+
+    void work(std::size_t index);
+
+public:
+    /**
+     * Constructs a pool that runs tasks on the given number of workers.
+     * The calling thread is one of the workers, so `size - 1` threads are started.
+     * On builds without thread support the pool always has a single worker.
+     *
+     * @param size The number of workers. Zero means one worker per hardware thread.
+     */
+    explicit ThreadPool(std::size_t size);
+
+    ThreadPool(const ThreadPool &) = delete;
+
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    ~ThreadPool();
+
+    /**
+     * @return The number of workers, including the calling thread.
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * Runs the task once on every worker and blocks until all of them finish.
+     * The task receives the index of the worker, in the range [0, size).
+     * Index 0 always runs on the calling thread.
+     * If the task throws on any worker, the other workers still finish, then the first
+     * exception is rethrown on the calling thread.
+     *
+     * @param task The task to run.
+     */
+    void run(const std::function<void(std::size_t)> &task);
+
+    /**
+     * @return The number of hardware threads available, at least 1.
+     * Always 1 on builds without thread support.
+     */
+    [[nodiscard]] static std::size_t concurrency();
+};
+
+#endif //FRUIT_CLASSIFIER_WASM_THREAD_POOL_H
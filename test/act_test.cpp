@@ -14,7 +14,7 @@ TEST(ActTest, ReluFunction) {
     EXPECT_EQ(f(-1), 0);
     EXPECT_EQ(f(-0.0001), 0);
     EXPECT_EQ(f(0), 0);
-    EXPECT_EQ(f(0.00001), 0.00001);
+    EXPECT_EQ(f(0.00001), nn::real_t(0.00001));
     EXPECT_EQ(f(1), 1);
 }
 
@@ -72,4 +72,48 @@ TEST(ActTest, Softmax) {
     test({1, 3, 2}, {0.0900305732, 0.6652409558, 0.2447284711});
     test({-1, 0, 0.5}, {0.1219516523, 0.3314989604, 0.5465493873});
     test({-1, 0, 2, 4, 2}, {0.00520014, 0.0141354461, 0.1044476041, 0.7717692058, 0.1044476041});
-}
\ No newline at end of file
+}
+
+TEST(ActTest, SoftmaxLargeValues) {
+    auto actual = nn::act::softmax({1001, 1003, 1002});
+    EXPECT_ALL_NEAR(actual, (nn::vd_t{0.0900305732, 0.6652409558, 0.2447284711}), EPSILON)
+}
+
+TEST(ActTest, KernelsMatchFunctions) {
+    nn::vd_t x;
+    for (int i = -200; i <= 200; ++i) { x.push_back(nn::real_t(i) / 20); }
+    nn::vd_t y(x.size()), g(x.size(), 0.5), d(x.size());
+    for (const auto &function: {nn::act::step, nn::act::sign, nn::act::linear,
+                                nn::act::relu, nn::act::sigmoid, nn::act::tanh}) {
+        auto kernel = nn::act::kernel(function);
+        ASSERT_NE(kernel, nullptr);
+        kernel->fun(x.data(), y.data(), x.size());
+        kernel->der(y.data(), g.data(), d.data(), x.size());
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            EXPECT_NEAR(y[i], function.fun(x[i]), EPSILON);
+            EXPECT_NEAR(d[i], g[i] * function.der(y[i]), EPSILON);
+        }
+    }
+}
+
+TEST(ActTest, KernelMissingForCustomFunction) {
+    nn::act::Function custom{[](nn::real_t x) { return x * x; }, [](nn::real_t x) { return 2 * x; }};
+    EXPECT_EQ(nn::act::kernel(custom), nullptr);
+}
+
+TEST(ActTest, FastKernelsApproximateFunctions) {
+    nn::vd_t x;
+    for (int i = -2000; i <= 2000; ++i) { x.push_back(nn::real_t(i) / 100); }
+    x.push_back(-1000);
+    x.push_back(1000);
+    nn::vd_t y(x.size());
+    // The bounds documented by act::Accuracy::Fast
+    double tolerance = sizeof(nn::real_t) == sizeof(float) ? 1e-6 : 1e-8;
+    nn::act::setAccuracy(nn::act::Accuracy::Fast);
+    for (const auto &function: {nn::act::sigmoid, nn::act::tanh}) {
+        nn::act::kernel(function)->fun(x.data(), y.data(), x.size());
+        for (std::size_t i = 0; i < x.size(); ++i) { EXPECT_NEAR(y[i], function.fun(x[i]), tolerance); }
+    }
+    nn::act::setAccuracy(nn::act::Accuracy::Exact);
+    EXPECT_EQ(nn::act::getAccuracy(), nn::act::Accuracy::Exact);
+}
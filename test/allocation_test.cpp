@@ -0,0 +1,126 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include <gtest/gtest.h>
+#include <network.h>
+#include <ensemble.h>
+#include <module.h>
+#include <static_network.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef NN_PROFILING
+namespace {
+    // Profiling builds link nn_alloc_counter, whose operator new counts per thread. Only the calling thread counts.
+    std::size_t allocationCount() { return nn::Profiler::threadAllocations(); }
+}
+#else
+namespace {
+    std::atomic<std::size_t> allocations{0};
+
+    std::size_t allocationCount() { return allocations.load(); }
+}
+
+void *operator new(std::size_t size) {
+    ++allocations;
+    if (void *p = std::malloc(size ? size : 1)) { return p; }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+#endif
+
+class AllocationTest : public ::testing::Test {
+protected:
+    nn::Network network;
+    nn::vd_t input, output;
+
+    AllocationTest() :
+            network(nn::make::network({4, 3, 4}, nn::act::tanh, nn::loss::sse)),
+            input({0.1, 0.7, -0.3, 0.5}),
+            output({0, 1, 0, 0}) {}
+};
+
+TEST_F(AllocationTest, TrainingStepDoesNotAllocate) {
+    network.train(input, output, 0.01);
+    auto before = allocationCount();
+    for (int i = 0; i < 10; ++i) { network.train(input, output, 0.01); }
+    EXPECT_EQ(allocationCount() - before, 0);
+}
+
+TEST_F(AllocationTest, BatchTrainingStepDoesNotAllocate) {
+    nn::vd_t inputs(input), outputs(output);
+    inputs.insert(inputs.end(), input.begin(), input.end());
+    outputs.insert(outputs.end(), output.begin(), output.end());
+    network.trainBatch(inputs, outputs, 0.01);
+    auto before = allocationCount();
+    for (int i = 0; i < 10; ++i) { network.trainBatch(inputs, outputs, 0.01); }
+    EXPECT_EQ(allocationCount() - before, 0);
+}
+
+TEST_F(AllocationTest, AdamTrainingStepDoesNotAllocate) {
+    network.setOptimizer(nn::Optimizer::adam());
+    network.train(input, output, 0.01);
+    auto before = allocationCount();
+    for (int i = 0; i < 10; ++i) { network.train(input, output, 0.01); }
+    EXPECT_EQ(allocationCount() - before, 0);
+}
+
+TEST_F(AllocationTest, PredictionDoesNotAllocate) {
+    nn::Network::Workspace workspace(network);
+    nn::vd_t expected = network.predict(input);
+    auto before = allocationCount();
+    for (int i = 0; i < 10; ++i) { (void) network.predict(input, workspace); }
+    EXPECT_EQ(allocationCount() - before, 0);
+    EXPECT_EQ(network.predict(input, workspace), expected);
+}
+
+TEST_F(AllocationTest, StaticPredictionDoesNotAllocate) {
+    nn::StaticNetwork<4, 3, 4> fixed(network);
+    nn::StaticNetwork<4, 3, 4>::input_t array{input[0], input[1], input[2], input[3]};
+    auto before = allocationCount();
+    for (int i = 0; i < 10; ++i) { (void) fixed.predict(array); }
+    EXPECT_EQ(allocationCount() - before, 0);
+}
+
+TEST_F(AllocationTest, EnsemblePredictionDoesNotAllocate) {
+    nn::Ensemble ensemble({network, network}, nn::Ensemble::Aggregation::Vote);
+    nn::vd_t outputs, buffer, stacked;
+    ensemble.predict(input, outputs, buffer, stacked);
+    auto before = allocationCount();
+    for (int i = 0; i < 10; ++i) { ensemble.predict(input, outputs, buffer, stacked); }
+    EXPECT_EQ(allocationCount() - before, 0);
+}
+
+TEST_F(AllocationTest, ModulePredictionDoesNotAllocate) {
+    nn::Module module;
+    module.setTrainInput({input, output});
+    module.setTrainOutput({output, input});
+    module.setNetwork(network);
+    nn::vd_t inputs(600 * input.size(), 0.25), outputs(600 * output.size());
+    for (std::size_t threads: {1, 2}) {
+        module.setThreads(threads);
+        module.predict(inputs.data(), 600, outputs.data());
+        auto before = allocationCount();
+        for (int i = 0; i < 10; ++i) { module.predict(inputs.data(), 600, outputs.data()); }
+        EXPECT_EQ(allocationCount() - before, 0);
+    }
+}
+
+TEST_F(AllocationTest, SynchronousEpochDoesNotAllocate) {
+    nn::vvd_t inputs(64, input), outputs(64, output);
+    nn::Module module(network);
+    module.setTrainInput(inputs);
+    module.setTrainOutput(outputs);
+    module.setThreads(2);
+    (void) module.train(1, 16);
+    auto before = allocationCount();
+    (void) module.train(1, 16);
+    // Only the errors returned by train are allocated, the replicas are kept from the first epoch
+    EXPECT_EQ(allocationCount() - before, 1);
+}
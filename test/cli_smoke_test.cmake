@@ -0,0 +1,61 @@
+# Trains nn_cli on a bundled dataset and scores its testing input without --fit,
+# then checks that every data row, and only those, got a prediction, that invalid options are rejected
+# and that categorical outputs are decoded with --fit-output.
+# Run by ctest with -DNN_CLI=<nn_cli> -DDATA=<dataset directory> -DFRUITS=<categorical dataset directory>
+# -DWORK=<scratch directory>.
+
+file(REMOVE_RECURSE ${WORK})
+file(MAKE_DIRECTORY ${WORK})
+
+execute_process(COMMAND ${NN_CLI} train --data ${DATA} --dimensions 20,8,1 --epochs 2 --report 1
+        --model ${WORK}/model.nnm RESULT_VARIABLE status OUTPUT_QUIET)
+if (NOT status EQUAL 0)
+    message(FATAL_ERROR "train failed: ${status}")
+endif ()
+
+execute_process(COMMAND ${NN_CLI} score --model ${WORK}/model.nnm --out ${WORK} ${DATA}/test_in.csv
+        RESULT_VARIABLE status OUTPUT_QUIET)
+if (NOT status EQUAL 0)
+    message(FATAL_ERROR "score failed: ${status}")
+endif ()
+
+# The expected outputs have a header row, the predictions don't
+file(STRINGS ${DATA}/test_out.csv expected)
+file(STRINGS ${WORK}/test_in_pred.csv predictions)
+list(LENGTH expected rows)
+list(LENGTH predictions scored)
+math(EXPR rows "${rows} - 1")
+if (NOT scored EQUAL rows)
+    message(FATAL_ERROR "${scored} predictions for ${rows} rows")
+endif ()
+
+# Invalid options are rejected before training
+foreach (options "--dimensions;20,1" "--dimensions;20,8,1;--epochs;-1" "--dimensions;20,8,1;--batch-size;-4")
+    execute_process(COMMAND ${NN_CLI} train --data ${DATA} ${options} --model ${WORK}/invalid.nnm
+            RESULT_VARIABLE status OUTPUT_QUIET ERROR_QUIET)
+    if (NOT status EQUAL 2)
+        message(FATAL_ERROR "train ${options} returned ${status}")
+    endif ()
+endforeach ()
+
+# Categorical outputs are decoded into their category names with --fit-output
+execute_process(COMMAND ${NN_CLI} train --data ${FRUITS} --dimensions 5,8,3 --encoding oneHot --epochs 2
+        --report 1 --model ${WORK}/fruits.nnm RESULT_VARIABLE status OUTPUT_QUIET)
+if (NOT status EQUAL 0)
+    message(FATAL_ERROR "train on fruits failed: ${status}")
+endif ()
+execute_process(COMMAND ${NN_CLI} score --model ${WORK}/fruits.nnm --fit ${FRUITS}/train_in.csv
+        --fit-output ${FRUITS}/train_out.csv --encoding oneHot --out ${WORK} ${FRUITS}/test_in.csv
+        RESULT_VARIABLE status OUTPUT_QUIET)
+if (NOT status EQUAL 0)
+    message(FATAL_ERROR "score with --fit-output failed: ${status}")
+endif ()
+file(STRINGS ${FRUITS}/train_out.csv categories)
+list(REMOVE_AT categories 0)
+file(STRINGS ${WORK}/test_in_pred.csv predictions)
+foreach (prediction ${predictions})
+    list(FIND categories ${prediction} index)
+    if (index EQUAL -1)
+        message(FATAL_ERROR "${prediction} isn't a category of ${FRUITS}/train_out.csv")
+    endif ()
+endforeach ()
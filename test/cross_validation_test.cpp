@@ -0,0 +1,105 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include <gtest/gtest.h>
+#include <cross_validation.h>
+
+#include <algorithm>
+
+#include "globals.h"
+
+class CrossValidationTest : public ::testing::Test {
+protected:
+    nn::vvd_t inputs, outputs;
+    nn::Network network = nn::make::network({2, 4, 1}, nn::act::tanh, nn::loss::sse);
+
+    void SetUp() override {
+        std::tie(inputs, outputs) = gridData(16, 4, 4, [](nn::real_t a, nn::real_t b) { return nn::vd_t{a * b}; });
+    }
+
+    nn::Module module() {
+        nn::Module m(network);
+        m.setTrainInput(inputs);
+        m.setTrainOutput(outputs);
+        return m;
+    }
+};
+
+TEST_F(CrossValidationTest, FoldsPartitionTheRows) {
+    nn::CrossValidation validation(module(), 5);
+    auto folds = validation.folds();
+    ASSERT_EQ(folds.size(), 5);
+    std::vector<std::size_t> all;
+    for (const auto &fold: folds) {
+        EXPECT_GE(fold.size(), 3);
+        EXPECT_LE(fold.size(), 4);
+        EXPECT_TRUE(std::is_sorted(fold.begin(), fold.end()));
+        all.insert(all.end(), fold.begin(), fold.end());
+    }
+    std::sort(all.begin(), all.end());
+    ASSERT_EQ(all.size(), inputs.size());
+    for (std::size_t i = 0; i < all.size(); ++i) { EXPECT_EQ(all[i], i); }
+
+    EXPECT_EQ(folds, validation.folds());
+    validation.setSeed(1);
+    EXPECT_NE(folds, validation.folds());
+}
+
+TEST_F(CrossValidationTest, HoldOutMatchesACopiedSplit) {
+    // The held out rows are inner points, the other rows keep the min-max parameters of all the rows
+    std::vector<std::size_t> held = {5, 6, 9, 10};
+    nn::Module split = module();
+    split.holdOut(held);
+
+    nn::vvd_t trainIn, trainOut, testIn, testOut;
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        bool test = std::find(held.begin(), held.end(), i) != held.end();
+        (test ? testIn : trainIn).push_back(inputs[i]);
+        (test ? testOut : trainOut).push_back(outputs[i]);
+    }
+    nn::Module copied(network);
+    copied.setTrainInput(trainIn);
+    copied.setTrainOutput(trainOut);
+    copied.setTestInput(testIn);
+    copied.setTestOutput(testOut);
+
+    auto expected = copied.trainAndTest(3, 2), actual = split.trainAndTest(3, 2);
+    for (std::size_t e = 0; e < 3; ++e) {
+        EXPECT_NEAR(actual[e].first, expected[e].first, EPSILON);
+        EXPECT_NEAR(actual[e].second, expected[e].second, EPSILON);
+    }
+
+    // New training data ends the split
+    split.setTrainInput(inputs);
+    split.setTrainOutput(outputs);
+    EXPECT_EQ(split.train(1, 4).size(), 1);
+}
+
+TEST_F(CrossValidationTest, TrainsFoldsInParallel) {
+    nn::CrossValidation validation(module(), 4);
+    validation.setThreads(3);
+    auto result = validation.run(5, 2);
+    ASSERT_EQ(result.folds.size(), 4);
+    ASSERT_EQ(result.trainErrors.size(), 5);
+    ASSERT_EQ(result.testErrors.size(), 5);
+
+    // Every fold matches a fold trained alone on the calling thread
+    auto folds = validation.folds();
+    for (std::size_t f = 0; f < folds.size(); ++f) {
+        nn::Module alone = module();
+        alone.holdOut(folds[f]);
+        auto errors = alone.trainAndTest(5, 2);
+        ASSERT_EQ(result.folds[f].testErrors.size(), 5);
+        for (std::size_t e = 0; e < 5; ++e) {
+            EXPECT_NEAR(result.folds[f].trainErrors[e], errors[e].first, EPSILON);
+            EXPECT_NEAR(result.folds[f].testErrors[e], errors[e].second, EPSILON);
+        }
+    }
+
+    for (std::size_t e = 0; e < 5; ++e) {
+        nn::real_t sum = 0;
+        for (const auto &fold: result.folds) { sum += fold.testErrors[e]; }
+        EXPECT_NEAR(result.testErrors[e], sum / 4, EPSILON);
+    }
+}
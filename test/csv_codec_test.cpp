@@ -0,0 +1,104 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include <gtest/gtest.h>
+#include <csv_codec.h>
+
+#include <sstream>
+
+#include "globals.h"
+
+TEST(CsvCodecTest, DetectsHeaders) {
+    nn::CsvCodec codec;
+    auto rows = codec.fit("COLOR,SWEETNESS\nRED,9\nORANGE,8\n");
+    EXPECT_EQ(codec.getHeaders(), (std::vector<std::string>{"COLOR", "SWEETNESS"}));
+    EXPECT_EQ(rows, (nn::vvd_t{{0, 9}, {1, 8}}));
+
+    nn::CsvCodec numeric;
+    rows = numeric.fit("0,1\n1,0\n\n", "Input");
+    EXPECT_EQ(numeric.getHeaders(), (std::vector<std::string>{"Input1", "Input2"}));
+    EXPECT_EQ(rows, (nn::vvd_t{{0, 1}, {1, 0}}));
+}
+
+TEST(CsvCodecTest, OneHotEncoding) {
+    nn::CsvCodec codec(nn::CsvCodec::Encoding::OneHot);
+    auto rows = codec.fit("FRUIT,SIZE\r\nAPPLE,3\r\nORANGE,4\r\nBANANA,5\r\nAPPLE,6\r\n");
+    EXPECT_EQ(codec.getHeaders(true),
+              (std::vector<std::string>{"FRUIT_APPLE", "FRUIT_ORANGE", "FRUIT_BANANA", "SIZE"}));
+    EXPECT_EQ(rows, (nn::vvd_t{{1, 0, 0, 3}, {0, 1, 0, 4}, {0, 0, 1, 5}, {1, 0, 0, 6}}));
+    EXPECT_EQ(codec.getCategories(0), (std::vector<std::string>{"APPLE", "ORANGE", "BANANA"}));
+    EXPECT_TRUE(codec.getCategories(1).empty());
+}
+
+TEST(CsvCodecTest, NumbersBeforeCategoriesBecomeCategories) {
+    nn::CsvCodec codec;
+    auto rows = codec.fit("1,0.5\n2,0.5\nX,1.5\n1,2\n");
+    EXPECT_EQ(codec.getCategories(0), (std::vector<std::string>{"1", "2", "X"}));
+    EXPECT_EQ(rows, (nn::vvd_t{{0, 0.5}, {1, 0.5}, {2, 1.5}, {0, 2}}));
+}
+
+TEST(CsvCodecTest, EncodesWithFittedColumns) {
+    nn::CsvCodec codec(nn::CsvCodec::Encoding::OneHot);
+    (void) codec.fit("COLOR,SWEETNESS\nRED,9\nORANGE,8\n");
+    auto rows = codec.encode("COLOR,SWEETNESS\nORANGE,7\nGREEN,2\n");
+    EXPECT_EQ(rows, (nn::vvd_t{{0, 1, 7}, {0, 0, 2}}));
+
+    nn::CsvCodec label;
+    (void) label.fit("COLOR\nRED\nORANGE\n");
+    EXPECT_EQ(label.encode("COLOR\nGREEN\nRED\n"), (nn::vvd_t{{-1}, {0}}));
+}
+
+TEST(CsvCodecTest, DecodesOutputs) {
+    nn::CsvCodec label;
+    (void) label.fit("FRUIT,SIZE\nAPPLE,3\nORANGE,4\nBANANA,5\n");
+    nn::vd_t row{0.8, 3.5};
+    EXPECT_EQ(label.decode(row.data()), (std::vector<std::string>{"ORANGE", "3.5"}));
+    row = {-0.7, 4};
+    EXPECT_EQ(label.decode(row.data()), (std::vector<std::string>{"APPLE", "4"}));
+    row = {7, 5};
+    EXPECT_EQ(label.decode(row.data()), (std::vector<std::string>{"BANANA", "5"}));
+
+    nn::CsvCodec oneHot(nn::CsvCodec::Encoding::OneHot);
+    (void) oneHot.fit("FRUIT,SIZE\nAPPLE,3\nORANGE,4\nBANANA,5\n");
+    row = {0.1, 0.3, 0.6, 0.25};
+    EXPECT_EQ(oneHot.decode(row.data()), (std::vector<std::string>{"BANANA", "0.25"}));
+}
+
+TEST(CsvCodecTest, UnfittedCodecSkipsHeaders) {
+    nn::CsvCodec codec;
+    EXPECT_EQ(codec.encode("A,B\n1,2\n3,4\n"), (nn::vvd_t{{1, 2}, {3, 4}}));
+    EXPECT_EQ(codec.encode("1,2\n3,4\n"), (nn::vvd_t{{1, 2}, {3, 4}}));
+}
+
+TEST(CsvCodecTest, StreamsAcrossChunks) {
+    std::ostringstream text;
+    text << "A,B,C\n";
+    std::size_t rows = 0;
+    while (text.tellp() < std::streamoff(3 * nn::CsvCodec::chunkSize)) {
+        text << rows << "," << (rows % 3 == 0 ? "left" : "right") << "," << rows * 0.25 << "\n";
+        ++rows;
+    }
+    std::istringstream in(text.str());
+    nn::CsvCodec streamed, whole;
+    auto actual = streamed.fit(in);
+    auto expected = whole.fit(text.str());
+    ASSERT_EQ(actual.size(), rows);
+    EXPECT_EQ(actual, expected);
+    nn::real_t last = nn::real_t(rows - 1);
+    EXPECT_EQ(actual.back(), (nn::vd_t{last, nn::real_t((rows - 1) % 3 == 0 ? 0 : 1), nn::real_t(last * 0.25)}));
+}
+
+TEST(CsvCodecTest, StreamsChunksWithOneNewline) {
+    // The second chunk holds a single newline, and so does the third one
+    std::string text;
+    while (text.size() < nn::CsvCodec::chunkSize) { text += "1,2\n"; }
+    text += "5,6\n" + std::string(nn::CsvCodec::chunkSize - 6, '0') + ",7\n8,9";
+    std::istringstream in(text);
+    nn::CsvCodec streamed, whole;
+    auto actual = streamed.fit(in);
+    auto expected = whole.fit(text);
+    ASSERT_EQ(actual.size(), nn::CsvCodec::chunkSize / 4 + 3);
+    EXPECT_EQ(actual, expected);
+    EXPECT_EQ(actual.back(), (nn::vd_t{8, 9}));
+}
@@ -0,0 +1,91 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include <gtest/gtest.h>
+#include <dataset.h>
+#include <module.h>
+
+#include "globals.h"
+
+TEST(DatasetTest, StoresRowsContiguously) {
+    nn::Dataset data({{1, 2, 3},
+                      {4, 5, 6}});
+    nn::vd_t expected = {1, 2, 3, 4, 5, 6};
+    EXPECT_EQ(data.size(), 2);
+    EXPECT_EQ(data.width(), 3);
+    EXPECT_ALL_NEAR(data.data(), expected, EPSILON)
+
+    nn::vd_t row = data.row(1).toVector();
+    nn::vd_t second = {4, 5, 6};
+    EXPECT_ALL_NEAR(row, second, EPSILON)
+    EXPECT_EQ(data.rows(0, 2).data(), data.data().data());
+    EXPECT_EQ(data.toRows(), (nn::vvd_t{{1, 2, 3}, {4, 5, 6}}));
+}
+
+TEST(DatasetTest, NormalizesWithFittedMinMax) {
+    nn::Dataset data({{0, 10},
+                      {2, 20},
+                      {4, 30}});
+    data.fitMinMax();
+    nn::vd_t normalized = data.normalized();
+    nn::vd_t expected = {0, 0, 0.5, 0.5, 1, 1};
+    EXPECT_ALL_NEAR(normalized, expected, EPSILON)
+
+    nn::vd_t last = data.normalized(2, 3).toVector();
+    nn::vd_t ones = {1, 1};
+    EXPECT_ALL_NEAR(last, ones, EPSILON)
+}
+
+TEST(DatasetTest, KeepsNormalizedRowsUntilChanged) {
+    nn::Dataset data({{0, 10},
+                      {4, 30}});
+    data.fitMinMax();
+    const nn::vd_t &normalized = data.normalized();
+    EXPECT_NEAR(normalized[2], 1, EPSILON);
+
+    // Same parameters, the cached rows are kept
+    data.setMinMax(data.getMinMax());
+    EXPECT_EQ(&data.normalized(), &normalized);
+    EXPECT_NEAR(data.normalized()[2], 1, EPSILON);
+
+    data.setMinMax({{0, 8}, {10, 30}});
+    EXPECT_NEAR(data.normalized()[2], 0.5, EPSILON);
+
+    data.set({{8, 30}});
+    EXPECT_NEAR(data.normalized()[0], 1, EPSILON);
+    EXPECT_NEAR(data.normalized()[1], 1, EPSILON);
+}
+
+TEST(DatasetTest, ModuleNormalizesTestingDataOnce) {
+    nn::vvd_t inputs, outputs;
+    for (int i = 0; i < 16; ++i) {
+        nn::real_t a = (i % 4) / nn::real_t(3), b = (i / 4) / nn::real_t(3);
+        inputs.push_back({a, b});
+        outputs.push_back({a * b});
+    }
+    nn::Module module(nn::make::network({2, 3, 1}, nn::act::tanh, nn::loss::sse));
+    module.setTestInput(inputs);
+    module.setTestOutput(outputs);
+    module.setTrainInput(inputs);
+    module.setTrainOutput(outputs);
+    EXPECT_EQ(module.getTestInput(), inputs);
+    EXPECT_EQ(module.getTrainOutput(), outputs);
+
+    // Testing uses the min-max parameters of the training data, even when set before it
+    nn::real_t error = module.test();
+    nn::Module reference(nn::make::network({2, 3, 1}, nn::act::tanh, nn::loss::sse));
+    reference.setTrainInput(inputs);
+    reference.setTrainOutput(outputs);
+    for (std::size_t l = 0; l < 2; ++l) {
+        reference.setParameters(l, module.getWeights(l).data(), module.getBiases(l).data());
+    }
+    reference.setTestInput(inputs);
+    reference.setTestOutput(outputs);
+    EXPECT_NEAR(error, reference.test(), EPSILON);
+
+    if (!nn::Profiler::enabled) { return; }
+    module.resetProfile();
+    (void) module.test(3);
+    EXPECT_EQ(module.getProfile().getAllocations(nn::Profiler::Phase::TestNormalization), 0);
+}
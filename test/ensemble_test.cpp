@@ -0,0 +1,110 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include <gtest/gtest.h>
+#include <ensemble.h>
+#include <module.h>
+
+#include <algorithm>
+
+#include "globals.h"
+
+using Aggregation = nn::Ensemble::Aggregation;
+
+class EnsembleTest : public ::testing::Test {
+protected:
+    nn::vd_t inputs = {0.1, 0.9, 0.4, 0.5, 0.8, 0.2, 0.3, 0.3};
+
+    static std::vector<nn::Network> networks(const nn::vi_t &dimensions, std::size_t count) {
+        std::vector<nn::Network> members;
+        for (std::size_t i = 0; i < count; ++i) {
+            members.push_back(nn::make::network(dimensions, nn::act::tanh, nn::loss::sse));
+        }
+        return members;
+    }
+};
+
+TEST_F(EnsembleTest, MeanMatchesSeparatePredictions) {
+    for (const nn::vi_t &dimensions: {nn::vi_t{2, 5, 3, 4}, nn::vi_t{2, 3, 1}}) {
+        auto members = networks(dimensions, 3);
+        nn::Ensemble ensemble(members);
+        EXPECT_EQ(ensemble.getSize(), 3);
+
+        nn::vd_t expected(inputs.size() / 2 * dimensions.back(), 0);
+        for (const auto &member: members) {
+            nn::vd_t y = member.predict(inputs);
+            for (std::size_t i = 0; i < y.size(); ++i) { expected[i] += y[i] / 3; }
+        }
+        nn::vd_t actual = ensemble.predict(inputs);
+        EXPECT_ALL_NEAR(actual, expected, EPSILON)
+    }
+}
+
+TEST_F(EnsembleTest, RejectsMismatchedMembers) {
+    EXPECT_THROW(nn::Ensemble(std::vector<nn::Network>{}), std::invalid_argument);
+    for (auto other: {nn::make::network({2, 4, 2}, nn::act::tanh, nn::loss::sse),
+                      nn::make::network({2, 3, 3, 2}, nn::act::tanh, nn::loss::sse),
+                      nn::make::network({2, 3, 2}, nn::act::relu, nn::loss::sse)}) {
+        auto members = networks({2, 3, 2}, 2);
+        members.push_back(other);
+        EXPECT_THROW(nn::Ensemble{members}, std::invalid_argument);
+    }
+}
+
+TEST_F(EnsembleTest, VotesForTheLargestOutputs) {
+    auto members = networks({2, 4, 3}, 5);
+    nn::Ensemble ensemble(members, Aggregation::Vote);
+    EXPECT_EQ(ensemble.getAggregation(), Aggregation::Vote);
+
+    nn::vd_t expected(inputs.size() / 2 * 3, 0);
+    for (const auto &member: members) {
+        nn::vd_t y = member.predict(inputs);
+        for (std::size_t row = 0; row < y.size() / 3; ++row) {
+            auto vote = std::max_element(y.begin() + row * 3, y.begin() + row * 3 + 3) - (y.begin() + row * 3);
+            expected[row * 3 + vote] += 0.2;
+        }
+    }
+    nn::vd_t outputs, buffer, stacked;
+    ensemble.predict(inputs, outputs, buffer, stacked);
+    EXPECT_ALL_NEAR(outputs, expected, EPSILON)
+}
+
+TEST_F(EnsembleTest, BaggingIsSeededAndParallel) {
+    auto [in, out] = gridData(16, 4, 4, [](nn::real_t a, nn::real_t b) {
+        return nn::vd_t{nn::real_t(a * b > 0.2 ? 1 : 0), nn::real_t(a * b > 0.2 ? 0 : 1)};
+    });
+    nn::Module module;
+    module.setLearningRate(0.1);
+    module.setTrainInput(in);
+    module.setTrainOutput(out);
+    auto members = networks({2, 4, 2}, 4);
+
+    auto serial = nn::Ensemble::bag(module, members, 10, 2, 3);
+    module.setThreads(3);
+    auto parallel = nn::Ensemble::bag(module, members, 10, 2, 3);
+    nn::vd_t a = serial.predict(inputs), b = parallel.predict(inputs);
+    EXPECT_ALL_NEAR(a, b, EPSILON)
+
+    // Members trained on different samples disagree, unlike the initial networks they started from
+    auto other = nn::Ensemble::bag(module, members, 10, 2, 4);
+    nn::vd_t c = other.predict(inputs);
+    EXPECT_GT(std::abs(c[0] - a[0]), EPSILON);
+}
+
+TEST_F(EnsembleTest, ModuleTrainsOnRepeatedRows) {
+    nn::vvd_t in = {{0, 0}, {1, 0}, {0, 1}}, out = {{0}, {1}, {1}};
+    auto network = nn::make::network({2, 3, 1}, nn::act::tanh, nn::loss::sse);
+    nn::Module sampled(network);
+    sampled.setTrainInput(in);
+    sampled.setTrainOutput(out);
+    sampled.setTrainRows({0, 0, 2});
+
+    // Same min-max parameters, the row left out isn't an extreme
+    nn::Module copied(network);
+    copied.setTrainInput({{0, 0}, {0, 0}, {1, 1}, {0, 1}});
+    copied.setTrainOutput({{0}, {0}, {1}, {1}});
+    copied.setTrainRows({0, 1, 3});
+    auto expected = copied.train(3, 2), actual = sampled.train(3, 2);
+    EXPECT_ALL_NEAR(actual, expected, EPSILON)
+}
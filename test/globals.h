@@ -6,11 +6,21 @@
 #define FRUIT_CLASSIFIER_WASM_GLOBALS_H
 
 #include <gtest/gtest.h>
+#include <nn.h>
+
+#include <tuple>
+#include <utility>
 
 #ifndef EPSILON
 #define EPSILON 1e-9
 #endif
 
+// Single precision builds can't meet the double precision tolerances
+#ifdef NN_FLOAT32
+#undef EPSILON
+#define EPSILON 1e-5
+#endif
+
 #define EXPECT_ALL_NEAR(val1, val2, abs_error) { \
     EXPECT_EQ(val1.size(), val2.size()); \
     for (std::size_t $i = 0; $i < val1.size(); ++$i) { \
@@ -18,4 +28,33 @@
     }\
 };
 
+/**
+ * Builds a dataset of points on a grid over the unit square, taken row by row and wrapping around the grid.
+ *
+ * @param count The number of rows of the dataset.
+ * @param columns The number of points on each row of the grid, at least 2.
+ * @param rows The number of rows of the grid, at least 2.
+ * @param target Maps the coordinates `a` and `b` of a point to its output row.
+ * @return The input rows `{a, b}` and their output rows.
+ */
+template<typename Target>
+std::pair<nn::vvd_t, nn::vvd_t> gridData(std::size_t count, std::size_t columns, std::size_t rows, Target target) {
+    nn::vvd_t inputs, outputs;
+    for (std::size_t i = 0; i < count; ++i) {
+        nn::real_t a = nn::real_t(i % columns) / nn::real_t(columns - 1);
+        nn::real_t b = nn::real_t(i / columns % rows) / nn::real_t(rows - 1);
+        inputs.push_back({a, b});
+        outputs.push_back(target(a, b));
+    }
+    return {inputs, outputs};
+}
+
+/**
+ * One-hot target of the opposite quadrants of the unit square, a problem no linear model solves.
+ */
+inline nn::vd_t quadrants(nn::real_t a, nn::real_t b) {
+    bool positive = (a > 0.5) != (b > 0.5);
+    return {nn::real_t(positive ? 0 : 1), nn::real_t(positive ? 1 : 0)};
+}
+
 #endif //FRUIT_CLASSIFIER_WASM_GLOBALS_H
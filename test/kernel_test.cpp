@@ -0,0 +1,41 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include <gtest/gtest.h>
+#include <nn.h>
+
+#define EPSILON 1e-12
+
+#include "globals.h"
+
+namespace {
+    nn::vd_t sequence(std::size_t n, double start, double step) {
+        nn::vd_t res(n);
+        for (std::size_t i = 0; i < n; ++i) { res[i] = start + step * static_cast<double>(i); }
+        return res;
+    }
+}
+
+TEST(KernelTest, DotMatchesScalar) {
+    for (std::size_t n = 0; n <= 19; ++n) {
+        nn::vd_t a = sequence(n, -0.5, 0.1), b = sequence(n, 0.3, -0.05);
+        double expected = 0;
+        for (std::size_t i = 0; i < n; ++i) { expected += a[i] * b[i]; }
+        EXPECT_NEAR(nn::kernel::dot(a.data(), b.data(), n), expected, EPSILON) << "n = " << n;
+    }
+}
+
+TEST(KernelTest, AxpyMatchesScalar) {
+    for (std::size_t n = 0; n <= 19; ++n) {
+        nn::vd_t x = sequence(n, 0.2, 0.07), y = sequence(n, -1, 0.11);
+        nn::vd_t expected(n);
+        for (std::size_t i = 0; i < n; ++i) { expected[i] = y[i] + -0.3 * x[i]; }
+        nn::kernel::axpy(-0.3, x.data(), y.data(), n);
+        EXPECT_ALL_NEAR(y, expected, EPSILON)
+    }
+}
+
+TEST(KernelTest, HasName) {
+    EXPECT_NE(std::string(nn::kernel::name()), "");
+}
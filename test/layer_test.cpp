@@ -104,4 +104,44 @@ TEST_F(LayerTest, CalculateGradientsForOutputLayer) {
     };
     nn::vd_t actual = outputLayer.calculateGradients(desired);
     EXPECT_ALL_NEAR(expected, actual, EPSILON)
-}
\ No newline at end of file
+}
+
+TEST_F(LayerTest, WeightsMatrixViews) {
+    EXPECT_EQ(outputLayer.size(), 3);
+    EXPECT_EQ(outputLayer.getInputSize(), 2);
+    EXPECT_EQ(outputLayer.getWeights().size(), 6);
+    EXPECT_ALL_NEAR(outputLayer.getWeights(1), no2, EPSILON)
+    EXPECT_NEAR(outputLayer.getBias(2), no3.getBias(), EPSILON);
+    EXPECT_EQ(outputLayer.getNeuron(0), no1);
+}
+
+TEST_F(LayerTest, AdjustMatchesNeuronAdjust) {
+    nn::vd_t input = {0.5, -0.5};
+    layer.activateAndCache(input);
+    nn::vd_t gradients = layer.calculateGradientsAndCash({0.4, -0.3});
+    layer.adjust(input, 0.1);
+
+    nn::Neuron n1 = nl1, n2 = nl2;
+    n1.adjust(input, gradients[0], 0.1);
+    n2.adjust(input, gradients[1], 0.1);
+    EXPECT_ALL_NEAR(layer.getWeights(0), n1, EPSILON)
+    EXPECT_ALL_NEAR(layer.getWeights(1), n2, EPSILON)
+    EXPECT_NEAR(layer.getBias(0), n1.getBias(), EPSILON);
+    EXPECT_NEAR(layer.getBias(1), n2.getBias(), EPSILON);
+}
+
+TEST_F(LayerTest, ActivateBatchMatchesSingleSamples) {
+    nn::vd_t x1 = {0.2, -0.1}, x2 = {-0.7, 0.4};
+    nn::vd_t expected = outputLayer.activate(x1);
+    nn::vd_t second = outputLayer.activate(x2);
+    expected.insert(expected.end(), second.begin(), second.end());
+    nn::vd_t actual = outputLayer.activate({0.2, -0.1, -0.7, 0.4});
+    EXPECT_ALL_NEAR(expected, actual, EPSILON)
+}
+
+TEST_F(LayerTest, SetParametersFromBuffers) {
+    nn::vd_t weights = {0.3, -0.4, 0.5, 0.6}, biases = {-0.7, 0.8};
+    layer.setParameters(weights.data(), biases.data());
+    EXPECT_ALL_NEAR(layer.getWeights(), weights, EPSILON)
+    EXPECT_ALL_NEAR(layer.getBiases(), biases, EPSILON)
+}
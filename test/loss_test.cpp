@@ -5,6 +5,8 @@
 #include <gtest/gtest.h>
 #include <nn.h>
 
+#include <cmath>
+
 constexpr auto epsilon = 1e-3;
 
 TEST(UtilTest, SSE) {
@@ -24,4 +26,24 @@ TEST(UtilTest, MSE) {
             {6, 7, 7, 8, 12, 14, 15, 16, 16, 19},
             {14, 15, 15, 17, 18, 18, 16, 14, 11, 8}
     ), 47.6, epsilon);
-}
\ No newline at end of file
+}
+
+TEST(UtilTest, CrossEntropy) {
+    EXPECT_NEAR(nn::loss::crossEntropy({0, 1, 0}, {0.2, 0.5, 0.3}), 0.6931471806, epsilon);
+    EXPECT_NEAR(nn::loss::crossEntropy({1}, {0.8}), 0.2231435513, epsilon);
+    EXPECT_NEAR(nn::loss::crossEntropy({0}, {0.8}), 1.6094379124, epsilon);
+    EXPECT_TRUE(std::isfinite(nn::loss::crossEntropy({1, 0}, {0, 1})));
+}
+
+TEST(UtilTest, SoftmaxCrossEntropy) {
+    nn::vd_t values{1, 3, 2}, desired{0, 0, 1}, gradients(3);
+    auto expected = nn::act::softmax(values);
+    auto loss = nn::loss::softmaxCrossEntropy(values.data(), desired.data(), gradients.data(), values.size());
+    EXPECT_NEAR(loss, nn::loss::crossEntropy(desired, expected), epsilon);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        EXPECT_NEAR(values[i], expected[i], epsilon);
+        EXPECT_NEAR(gradients[i], expected[i] - desired[i], epsilon);
+    }
+    nn::vd_t large{1000, -1000};
+    EXPECT_NEAR(nn::loss::softmaxCrossEntropy(large.data(), desired.data() + 1, gradients.data(), 2), 2000, epsilon);
+}
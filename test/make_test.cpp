@@ -0,0 +1,102 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include <gtest/gtest.h>
+#include <network.h>
+#include <thread_pool.h>
+
+#include <cmath>
+
+namespace {
+    nn::vd_t parameters(const nn::Network &network) {
+        nn::vd_t values;
+        for (std::size_t i = 0; i < network.getSize(); ++i) {
+            const nn::Layer &layer = network.get(i);
+            values.insert(values.end(), layer.getWeights().begin(), layer.getWeights().end());
+            values.insert(values.end(), layer.getBiases().begin(), layer.getBiases().end());
+        }
+        return values;
+    }
+
+    /**
+     * @return The largest absolute weight of the layer, expecting all its biases to be zero.
+     */
+    nn::real_t largestWeight(const nn::Layer &layer) {
+        for (nn::real_t bias: layer.getBiases()) { EXPECT_EQ(bias, 0); }
+        nn::real_t largest = 0;
+        for (nn::real_t w: layer.getWeights()) { largest = std::max(largest, std::abs(w)); }
+        return largest;
+    }
+}
+
+TEST(MakeTest, SameSeedMakesSameNetwork) {
+    for (auto init: {nn::make::Init::Range, nn::make::Init::Xavier, nn::make::Init::He, nn::make::Init::Auto}) {
+        nn::make::seed(3);
+        auto first = parameters(nn::make::network({4, 8, 3}, nn::act::relu, nn::loss::sse, init));
+        nn::make::seed(3);
+        auto second = parameters(nn::make::network({4, 8, 3}, nn::act::relu, nn::loss::sse, init));
+        nn::make::seed(4);
+        auto other = parameters(nn::make::network({4, 8, 3}, nn::act::relu, nn::loss::sse, init));
+        EXPECT_EQ(first, second);
+        EXPECT_NE(first, other);
+    }
+}
+
+TEST(MakeTest, XavierAndHeLimits) {
+    nn::make::seed(0);
+    auto xavier = nn::make::network({100, 50, 10}, nn::act::tanh, nn::loss::sse, nn::make::Init::Xavier);
+    auto he = nn::make::network({100, 50, 10}, nn::act::tanh, nn::loss::sse, nn::make::Init::He);
+    nn::real_t xavierLimit = std::sqrt(6.0 / 150), heLimit = std::sqrt(6.0 / 100);
+
+    nn::real_t largest = largestWeight(xavier.get(0));
+    EXPECT_LE(largest, xavierLimit);
+    EXPECT_GT(largest, xavierLimit * 0.9);
+    largest = largestWeight(he.get(0));
+    EXPECT_LE(largest, heLimit);
+    EXPECT_GT(largest, heLimit * 0.9);
+}
+
+TEST(MakeTest, AutoPicksHeForRelu) {
+    nn::make::seed(5);
+    nn::Network automatic = nn::make::network({6, 8, 8, 2}, nn::act::relu, nn::loss::sse);
+    nn::make::seed(5);
+    nn::Network he = nn::make::network({6, 8, 8, 2}, nn::act::relu, nn::loss::sse, nn::make::Init::He);
+    EXPECT_EQ(automatic.get(0).getWeights(), he.get(0).getWeights());
+    EXPECT_EQ(automatic.get(1).getWeights(), he.get(1).getWeights());
+    // The output layer is initialized with Xavier
+    EXPECT_LE(largestWeight(automatic.get(2)), std::sqrt(6.0 / 10));
+    EXPECT_GT(largestWeight(he.get(2)), std::sqrt(6.0 / 10));
+
+    nn::make::seed(5);
+    auto tanh = parameters(nn::make::network({6, 8, 2}, nn::act::tanh, nn::loss::sse));
+    nn::make::seed(5);
+    EXPECT_EQ(tanh, parameters(nn::make::network({6, 8, 2}, nn::act::tanh, nn::loss::sse, nn::make::Init::Xavier)));
+}
+
+TEST(MakeTest, RangeKeepsTheWidthScaledRange) {
+    nn::make::seed(0);
+    nn::Network network = nn::make::network({3, 24, 2}, nn::act::tanh, nn::loss::sse, nn::make::Init::Range);
+    nn::real_t limit = 24 / 2.4, largest = 0;
+    for (nn::real_t w: parameters(network)) { largest = std::max(largest, std::abs(w)); }
+    EXPECT_LE(largest, limit);
+    EXPECT_GT(largest, 1);
+}
+
+TEST(MakeTest, ThreadsHaveTheirOwnGenerators) {
+    nn::make::seed(9);
+    auto expected = parameters(nn::make::network({5, 16, 4}, nn::act::tanh, nn::loss::sse));
+
+    nn::ThreadPool pool(4);
+    std::vector<nn::vd_t> actual(pool.size());
+    pool.run([&actual](std::size_t i) {
+        // Draws a different amount on every thread, which mustn't shift the draws of the others
+        nn::make::seed(9);
+        for (std::size_t round = 0; round <= i; ++round) {
+            (void) nn::make::network({3, 3, 3}, nn::act::relu, nn::loss::sse);
+        }
+        nn::make::seed(9);
+        actual[i] = parameters(nn::make::network({5, 16, 4}, nn::act::tanh, nn::loss::sse));
+    });
+    for (const auto &values: actual) { EXPECT_EQ(values, expected); }
+}
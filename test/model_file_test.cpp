@@ -0,0 +1,101 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include <gtest/gtest.h>
+#include <module.h>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "globals.h"
+
+class ModelFileTest : public ::testing::Test {
+protected:
+    std::string path;
+    nn::Module module;
+    nn::vvd_t inputs;
+
+    ModelFileTest() :
+            path(::testing::TempDir() + "model_file_test.bin"),
+            module(nn::make::network({3, 5, 4, 2}, {nn::act::relu, nn::act::tanh}, nn::loss::crossEntropy)) {
+        nn::vvd_t outputs;
+        for (int i = 0; i < 12; ++i) {
+            inputs.push_back({nn::real_t(i), nn::real_t(i % 3) * 10, nn::real_t(-i) / 4});
+            outputs.push_back({nn::real_t(i % 2), nn::real_t(1 - i % 2)});
+        }
+        module.setTrainInput(inputs);
+        module.setTrainOutput(outputs);
+        module.train(3, 4);
+    }
+
+    ~ModelFileTest() override { std::remove(path.c_str()); }
+};
+
+TEST_F(ModelFileTest, SaveAndLoadKeepPredictions) {
+    ASSERT_TRUE(module.save(path));
+    nn::Module loaded;
+    ASSERT_TRUE(loaded.load(path));
+    EXPECT_EQ(loaded.getWeights(), module.getWeights());
+    EXPECT_EQ(loaded.getBiases(), module.getBiases());
+    EXPECT_EQ(loaded.predict(inputs), module.predict(inputs));
+}
+
+TEST_F(ModelFileTest, MappedPredictionsMatchModule) {
+    ASSERT_TRUE(module.save(path));
+    auto file = nn::ModelFile::open(path);
+    ASSERT_TRUE(file.has_value());
+    EXPECT_EQ(file->getDimensions(), (std::vector<std::size_t>{3, 5, 4, 2}));
+    nn::vd_t x, y(inputs.size() * 2);
+    for (const auto &row: inputs) { x.insert(x.end(), row.begin(), row.end()); }
+    file->predict(x.data(), inputs.size(), y.data());
+    auto expected = module.predict(inputs);
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        EXPECT_NEAR(y[2 * i], expected[i][0], EPSILON);
+        EXPECT_NEAR(y[2 * i + 1], expected[i][1], EPSILON);
+    }
+}
+
+TEST_F(ModelFileTest, RejectsInvalidFiles) {
+    EXPECT_FALSE(nn::ModelFile::open(path).has_value());
+    std::ofstream(path) << "not a model";
+    EXPECT_FALSE(nn::ModelFile::open(path).has_value());
+    nn::Module unchanged(module);
+    EXPECT_FALSE(unchanged.load(path));
+    EXPECT_EQ(unchanged.getWeights(), module.getWeights());
+
+    ASSERT_TRUE(module.save(path));
+    std::string valid;
+    {
+        std::ifstream in(path, std::ios::binary);
+        valid.assign(std::istreambuf_iterator<char>(in), {});
+    }
+    auto rejects = [this](const std::string &bytes) {
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes;
+        return !nn::ModelFile::open(path).has_value();
+    };
+    auto withWord = [&valid](std::size_t offset, std::uint32_t value) {
+        std::string bytes = valid;
+        std::memcpy(bytes.data() + offset, &value, sizeof(value));
+        return bytes;
+    };
+
+    // The number of layers is at byte 20, the dimensions follow the 32 bytes of the header
+    EXPECT_TRUE(rejects(valid.substr(0, 32)));
+    EXPECT_TRUE(rejects(valid.substr(0, 40)));
+    EXPECT_TRUE(rejects(valid.substr(0, valid.size() - 1)));
+    EXPECT_TRUE(rejects(withWord(20, 0x80000000).substr(0, 32)));
+    EXPECT_TRUE(rejects(withWord(20, 0xFFFFFFFF).substr(0, 32)));
+    EXPECT_TRUE(rejects(withWord(20, 0xFFFFFFFF)));
+    EXPECT_TRUE(rejects(withWord(20, 1000)));
+    EXPECT_TRUE(rejects(withWord(32, 0xFFFFFFFF)));
+    EXPECT_TRUE(rejects(withWord(36, 0xFFFFFFFF)));
+    EXPECT_FALSE(rejects(valid));
+}
+
+TEST_F(ModelFileTest, RejectsCustomFunctions) {
+    nn::act::Function square{[](nn::real_t x) { return x * x; }, [](nn::real_t x) { return 2 * x; }};
+    nn::Module custom(nn::make::network({2, 3, 2}, square, nn::loss::sse));
+    EXPECT_FALSE(custom.save(path));
+}
@@ -0,0 +1,167 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include <gtest/gtest.h>
+#include <module.h>
+
+#include "globals.h"
+
+class ModuleTest : public ::testing::Test {
+protected:
+    nn::Network network;
+    nn::vvd_t inputs, outputs;
+
+    // Seeded, so the accuracy checks don't depend on the luck of the initial weights
+    static nn::Network seeded() {
+        nn::make::seed(1);
+        return nn::make::network({2, 4, 2}, nn::act::tanh, nn::loss::sse);
+    }
+
+    ModuleTest() : network(seeded()) {
+        std::tie(inputs, outputs) = gridData(64, 8, 8, quadrants);
+    }
+
+    nn::Module module() const {
+        nn::Module m(network);
+        m.setLearningRate(0.1);
+        m.setTrainInput(inputs);
+        m.setTrainOutput(outputs);
+        return m;
+    }
+};
+
+TEST_F(ModuleTest, SynchronousMatchesSingleThreaded) {
+    nn::Module serial = module(), parallel = module();
+    parallel.setThreads(4);
+    nn::vd_t expected = serial.train(5, 16);
+    nn::vd_t actual = parallel.train(5, 16);
+    EXPECT_ALL_NEAR(expected, actual, EPSILON)
+    EXPECT_ALL_NEAR(serial.getWeights()[0][0], parallel.getWeights()[0][0], EPSILON)
+}
+
+TEST_F(ModuleTest, NonDeterministicSynchronousMatchesSingleThreaded) {
+    nn::Module serial = module(), parallel = module();
+    parallel.setThreads(3);
+    parallel.setDeterministic(false);
+    nn::vd_t expected = serial.train(5, 8);
+    nn::vd_t actual = parallel.train(5, 8);
+    EXPECT_ALL_NEAR(expected, actual, EPSILON)
+}
+
+TEST_F(ModuleTest, HogwildReducesError) {
+    for (const auto &optimizer: {nn::Optimizer::sgd(), nn::Optimizer::adam()}) {
+        nn::Module m = module();
+        m.setOptimizer(optimizer);
+        m.setThreads(4);
+        m.setParallelMode(nn::Module::ParallelMode::Hogwild);
+        nn::vd_t errors = m.train(200, 2);
+        EXPECT_LT(errors.back(), errors.front());
+    }
+}
+
+TEST_F(ModuleTest, ParallelPredictionMatchesRowByRow) {
+    nn::Module m = module();
+    m.train(3, 4);
+    nn::vvd_t data;
+    for (int i = 0; i < 1000; ++i) { data.push_back(inputs[i % inputs.size()]); }
+
+    m.setThreads(4);
+    nn::vvd_t actual = m.predict(data);
+    ASSERT_EQ(actual.size(), data.size());
+
+    m.setThreads(1);
+    for (std::size_t i = 0; i < data.size(); i += 97) {
+        nn::vvd_t expected = m.predict(nn::vvd_t{data[i]});
+        EXPECT_ALL_NEAR(actual[i], expected[0], EPSILON)
+    }
+}
+
+TEST_F(ModuleTest, PredictIntoBuffer) {
+    nn::Module m = module();
+    nn::vd_t flat;
+    for (const auto &row: inputs) { flat.insert(flat.end(), row.begin(), row.end()); }
+    nn::vd_t outputBuffer(inputs.size() * 2);
+    m.predict(flat.data(), inputs.size(), outputBuffer.data());
+    nn::vvd_t expected = m.predict(inputs);
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        EXPECT_NEAR(outputBuffer[2 * i], expected[i][0], EPSILON);
+        EXPECT_NEAR(outputBuffer[2 * i + 1], expected[i][1], EPSILON);
+    }
+}
+
+TEST_F(ModuleTest, QuantizedAccuracyStaysClose) {
+    nn::Module m = module();
+    m.setTestInput(inputs);
+    m.setTestOutput(outputs);
+    m.train(300, 4);
+    auto report = m.compare(m.quantize());
+    EXPECT_GT(report.accuracy, 0.5);
+    EXPECT_NEAR(report.quantizedAccuracy, report.accuracy, 0.1);
+    EXPECT_LT(report.maxDifference, 0.1);
+}
+
+TEST_F(ModuleTest, StackedDataMatchesRows) {
+    nn::vd_t stackedInputs, stackedOutputs;
+    for (const auto &row: inputs) { stackedInputs.insert(stackedInputs.end(), row.begin(), row.end()); }
+    for (const auto &row: outputs) { stackedOutputs.insert(stackedOutputs.end(), row.begin(), row.end()); }
+    nn::Module rows = module(), stacked(network);
+    stacked.setLearningRate(0.1);
+    stacked.setTrainInput(stackedInputs.data(), inputs.size(), 2);
+    stacked.setTrainOutput(stackedOutputs.data(), outputs.size(), 2);
+    stacked.setTestInput(stackedInputs.data(), inputs.size(), 2);
+    rows.setTestInput(inputs);
+    nn::vd_t expectedErrors = rows.train(3, 8), actualErrors = stacked.train(3, 8);
+    EXPECT_ALL_NEAR(expectedErrors, actualErrors, EPSILON)
+
+    nn::vd_t predictions;
+    stacked.predict(predictions);
+    auto expected = rows.predict();
+    ASSERT_EQ(predictions.size(), expected.size() * 2);
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        nn::vd_t row(predictions.begin() + 2 * i, predictions.begin() + 2 * i + 2);
+        EXPECT_ALL_NEAR(expected[i], row, EPSILON)
+    }
+
+    auto weights = stacked.getWeights(0);
+    EXPECT_EQ(weights.size(), 8u);
+    nn::vd_t neuron(weights.begin() + 2, weights.begin() + 4), biases = stacked.getBiases(1).toVector();
+    EXPECT_ALL_NEAR(stacked.getWeights()[0][1], neuron, EPSILON)
+    EXPECT_ALL_NEAR(stacked.getBiases()[1], biases, EPSILON)
+}
+
+TEST_F(ModuleTest, ShuffledFullBatchMatchesSequential) {
+    // A full batch sums the gradients of every row, so any permutation gives the same update.
+    nn::Module sequential = module(), shuffled = module();
+    shuffled.setSampling(nn::Module::Sampling::Shuffle);
+    nn::vd_t expected = sequential.train(3, inputs.size());
+    nn::vd_t actual = shuffled.train(3, inputs.size());
+    EXPECT_ALL_NEAR(expected, actual, EPSILON)
+}
+
+TEST_F(ModuleTest, SamplingIsReproducibleWithSeed) {
+    for (auto sampling: {nn::Module::Sampling::Shuffle, nn::Module::Sampling::Stratified,
+                         nn::Module::Sampling::Bootstrap}) {
+        nn::Module first = module(), second = module(), sequential = module();
+        first.setSampling(sampling);
+        second.setSampling(sampling);
+        first.setSeed(7);
+        second.setSeed(7);
+        nn::vd_t expected = first.train(3, 4);
+        nn::vd_t actual = second.train(3, 4);
+        EXPECT_ALL_NEAR(expected, actual, EPSILON)
+        nn::vd_t ordered = sequential.train(3, 4);
+        EXPECT_NE(ordered, actual);
+    }
+}
+
+TEST_F(ModuleTest, SampledParallelTrainingReducesError) {
+    for (auto mode: {nn::Module::ParallelMode::Synchronous, nn::Module::ParallelMode::Hogwild}) {
+        nn::Module m = module();
+        m.setThreads(4);
+        m.setParallelMode(mode);
+        m.setSampling(nn::Module::Sampling::Stratified);
+        nn::vd_t errors = m.train(100, 2);
+        EXPECT_LT(errors.back(), errors.front());
+    }
+}
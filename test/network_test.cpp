@@ -60,4 +60,41 @@ TEST_F(NetworkTest, SimpleTrainingTest) {
     nn::vd_t expected = {0.316920916177, 0.683079083822};
     double error = network.train(input, output, alpha);
     EXPECT_NEAR(error, nn::loss::sse(output, expected), EPSILON);
-}
\ No newline at end of file
+}
+
+TEST_F(NetworkTest, BatchOfOneMatchesSingleTraining) {
+    nn::Network other = network;
+    double error = network.train({1, 0}, {0, 1}, alpha);
+    double batchError = other.trainBatch({1, 0}, {0, 1}, alpha);
+    EXPECT_NEAR(error, batchError, EPSILON);
+    for (std::size_t i = 0; i < network.getSize(); ++i) {
+        EXPECT_ALL_NEAR(network.get(i).getWeights(), other.get(i).getWeights(), EPSILON)
+        EXPECT_ALL_NEAR(network.get(i).getBiases(), other.get(i).getBiases(), EPSILON)
+    }
+}
+
+TEST_F(NetworkTest, BatchAveragesGradients) {
+    nn::Network other = network;
+    network.train({1, 0}, {0, 1}, alpha);
+    double batchError = other.trainBatch({1, 0, 1, 0}, {0, 1, 0, 1}, alpha);
+    nn::vd_t expected = {0.316920916177, 0.683079083822};
+    EXPECT_NEAR(batchError, 2 * nn::loss::sse({0, 1}, expected), EPSILON);
+    for (std::size_t i = 0; i < network.getSize(); ++i) {
+        EXPECT_ALL_NEAR(network.get(i).getWeights(), other.get(i).getWeights(), EPSILON)
+    }
+}
+
+TEST_F(NetworkTest, FusedCrossEntropyMatchesUnfusedGradients) {
+    nn::Network fused({l1, l2}, l3, nn::loss::crossEntropy);
+    nn::vd_t inputs{1, 0, 0.3, -0.4}, outputs{0, 1, 1, 0};
+    auto before = network.predict({1, 0});
+    auto loss = fused.trainBatch(inputs, outputs, alpha);
+    network.trainBatch(inputs, outputs, alpha);
+    for (std::size_t i = 0; i < network.getSize(); ++i) {
+        EXPECT_ALL_NEAR(fused.get(i).getWeights(), network.get(i).getWeights(), EPSILON)
+        EXPECT_ALL_NEAR(fused.get(i).getBiases(), network.get(i).getBiases(), EPSILON)
+    }
+    auto second = nn::Network({l1, l2}, l3, nn::loss::sse).predict({0.3, -0.4});
+    auto expected = nn::loss::crossEntropy({0, 1}, before) + nn::loss::crossEntropy({1, 0}, second);
+    EXPECT_NEAR(loss, expected, EPSILON);
+}
@@ -0,0 +1,96 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include <gtest/gtest.h>
+#include <module.h>
+
+#include <cmath>
+
+#include "globals.h"
+
+using Method = nn::Optimizer::Method;
+
+TEST(OptimizerTest, SGDScalesGradients) {
+    nn::vd_t parameters = {1, 2}, gradients = {4, -2};
+    nn::Optimizer::sgd().update(parameters.data(), gradients.data(), nullptr, nullptr, 2, 0.1, 0.5, 1);
+    nn::vd_t expected = {0.8, 2.1};
+    EXPECT_ALL_NEAR(parameters, expected, EPSILON)
+}
+
+TEST(OptimizerTest, MomentumAccumulatesSteps) {
+    nn::vd_t parameters = {0}, gradients = {1}, velocity = {0};
+    nn::Optimizer optimizer = nn::Optimizer::momentum(0.5);
+    optimizer.update(parameters.data(), gradients.data(), velocity.data(), nullptr, 1, 0.1, 1, 1);
+    EXPECT_NEAR(parameters[0], -0.1, EPSILON);
+    optimizer.update(parameters.data(), gradients.data(), velocity.data(), nullptr, 1, 0.1, 1, 2);
+    EXPECT_NEAR(velocity[0], 1.5, EPSILON);
+    EXPECT_NEAR(parameters[0], -0.25, EPSILON);
+
+    nn::vd_t lookAhead = {0};
+    velocity = {0};
+    nn::Optimizer::momentum(0.5, true).update(lookAhead.data(), gradients.data(), velocity.data(), nullptr, 1,
+                                              0.1, 1, 1);
+    EXPECT_NEAR(lookAhead[0], -0.15, EPSILON);
+}
+
+TEST(OptimizerTest, AdaptiveStepsDontDependOnGradientScale) {
+    for (const auto &optimizer: {nn::Optimizer::rmsprop(), nn::Optimizer::adam()}) {
+        nn::vd_t small = {0}, large = {0}, first = {0, 0}, second = {0, 0};
+        nn::vd_t smallGradient = {0.01}, largeGradient = {100};
+        optimizer.update(small.data(), smallGradient.data(), first.data(), second.data(), 1, 0.01, 1, 1);
+        optimizer.update(large.data(), largeGradient.data(), first.data() + 1, second.data() + 1, 1, 0.01, 1, 1);
+        EXPECT_NEAR(small[0], large[0], 1e-5);
+    }
+    // Adam's bias correction makes the first step exactly the learning rate
+    nn::vd_t parameter = {0}, gradient = {3}, first = {0}, second = {0};
+    nn::Optimizer::adam().update(parameter.data(), gradient.data(), first.data(), second.data(), 1, 0.01, 1, 1);
+    EXPECT_NEAR(parameter[0], -0.01, 1e-6);
+}
+
+class OptimizerModuleTest : public ::testing::Test {
+protected:
+    nn::Network network;
+    nn::vvd_t inputs, outputs;
+
+    OptimizerModuleTest() :
+            network(nn::make::network({2, 4, 2}, nn::act::tanh, nn::loss::sse)) {
+        std::tie(inputs, outputs) = gridData(32, 4, 4, quadrants);
+    }
+
+    nn::Module module(const nn::Optimizer &optimizer) const {
+        nn::Module m(network);
+        m.setOptimizer(optimizer);
+        m.setLearningRate(0.01);
+        m.setTrainInput(inputs);
+        m.setTrainOutput(outputs);
+        return m;
+    }
+};
+
+TEST_F(OptimizerModuleTest, EveryOptimizerReducesError) {
+    for (const auto &optimizer: {nn::Optimizer::sgd(), nn::Optimizer::momentum(), nn::Optimizer::momentum(0.9, true),
+                                 nn::Optimizer::rmsprop(), nn::Optimizer::adam()}) {
+        nn::Module m = module(optimizer);
+        nn::vd_t errors = m.train(50, 4);
+        EXPECT_LT(errors.back(), errors.front());
+    }
+}
+
+TEST_F(OptimizerModuleTest, SynchronousAdamMatchesSingleThreaded) {
+    nn::Module serial = module(nn::Optimizer::adam()), parallel = module(nn::Optimizer::adam());
+    parallel.setThreads(4);
+    nn::vd_t expected = serial.train(5, 8);
+    nn::vd_t actual = parallel.train(5, 8);
+    EXPECT_ALL_NEAR(expected, actual, EPSILON)
+    EXPECT_ALL_NEAR(serial.getWeights()[0][0], parallel.getWeights()[0][0], EPSILON)
+}
+
+TEST_F(OptimizerModuleTest, OptimizerIsKeptForNewNetworks) {
+    nn::Module m = module(nn::Optimizer::rmsprop());
+    m.setNetwork(network);
+    EXPECT_EQ(m.getOptimizer().getMethod(), Method::RMSProp);
+    nn::Network adam = network;
+    adam.setOptimizer(nn::Optimizer::adam());
+    EXPECT_EQ(nn::Module(adam).getOptimizer().getMethod(), Method::Adam);
+}
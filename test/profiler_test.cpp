@@ -0,0 +1,98 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include <gtest/gtest.h>
+#include <module.h>
+
+#include <new>
+
+#include "globals.h"
+
+using Phase = nn::Profiler::Phase;
+
+class ProfilerTest : public ::testing::Test {
+protected:
+    nn::vvd_t inputs, outputs;
+
+    ProfilerTest() {
+        std::tie(inputs, outputs) = gridData(32, 8, 4, [](nn::real_t a, nn::real_t b) {
+            return nn::vd_t{a * b, nn::real_t(a > b ? 1 : 0)};
+        });
+    }
+
+    nn::Module module(std::size_t threads) const {
+        nn::Module m(nn::make::network({2, 4, 2}, nn::act::tanh, nn::loss::sse));
+        m.setThreads(threads);
+        m.setTrainInput(inputs);
+        m.setTrainOutput(outputs);
+        m.setTestInput(inputs);
+        m.setTestOutput(outputs);
+        return m;
+    }
+};
+
+TEST_F(ProfilerTest, CountsTrainingPhases) {
+    nn::Module m = module(1);
+    // The first batch grows the caches of the layers.
+    (void) m.train(1, 8);
+    m.resetProfile();
+    (void) m.trainAndTest(3, 8);
+    nn::Profiler profile = m.getProfile();
+    if (!nn::Profiler::enabled) {
+        EXPECT_EQ(profile.getSamples(), 0);
+        EXPECT_EQ(profile.getSamplesPerSecond(), 0);
+        return;
+    }
+    EXPECT_EQ(profile.getSamples(), 3 * inputs.size());
+    for (auto phase: {Phase::Forward, Phase::Loss, Phase::Backward, Phase::Update, Phase::TestNormalization,
+                      Phase::Epoch}) {
+        EXPECT_GT(profile.getSeconds(phase), 0);
+    }
+    EXPECT_GT(profile.getSamplesPerSecond(), 0);
+    EXPECT_EQ(profile.getAllocations(Phase::Forward), 0);
+    EXPECT_GT(profile.getAllocations(Phase::TestNormalization), 0);
+
+    m.resetProfile();
+    EXPECT_EQ(m.getProfile().getSamples(), 0);
+    EXPECT_EQ(m.getProfile().getSeconds(Phase::Epoch), 0);
+}
+
+TEST_F(ProfilerTest, MergesWorkerCounters) {
+    for (auto mode: {nn::Module::ParallelMode::Synchronous, nn::Module::ParallelMode::Hogwild}) {
+        nn::Module m = module(4);
+        m.setParallelMode(mode);
+        m.resetProfile();
+        (void) m.train(2, 8);
+        EXPECT_EQ(m.getProfile().getSamples(), nn::Profiler::enabled ? 2 * inputs.size() : 0);
+    }
+}
+
+TEST_F(ProfilerTest, CountsEveryFormOfNew) {
+    if (!nn::Profiler::enabled) { return; }
+    struct alignas(64) Aligned {
+        char bytes[64];
+    };
+    // Kept in a volatile, so the compiler can't elide the pairs of new and delete
+    static void *volatile kept;
+    auto before = nn::Profiler::threadAllocations();
+    auto *single = new int(1);
+    kept = single;
+    delete single;
+    auto *array = new int[4];
+    kept = array;
+    delete[] array;
+    auto *aligned = new Aligned;
+    kept = aligned;
+    delete aligned;
+    auto *alignedArray = new Aligned[2];
+    kept = alignedArray;
+    delete[] alignedArray;
+    auto *nothrow = new(std::nothrow) int(1);
+    kept = nothrow;
+    delete nothrow;
+    auto *nothrowArray = new(std::nothrow) Aligned[2];
+    kept = nothrowArray;
+    delete[] nothrowArray;
+    EXPECT_EQ(nn::Profiler::threadAllocations() - before, 6);
+}
@@ -0,0 +1,66 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include <gtest/gtest.h>
+#include <quantized_network.h>
+
+#include <cmath>
+
+#include "globals.h"
+
+class QuantizedNetworkTest : public ::testing::Test {
+protected:
+    nn::Network network;
+    nn::vd_t inputs;
+
+    /**
+     * Deterministic neurons, so the quantization error doesn't depend on random weights.
+     */
+    static nn::vn_t neurons(std::size_t inputs, std::size_t size) {
+        nn::vn_t result;
+        for (std::size_t i = 0; i < size; ++i) {
+            nn::vd_t weights(inputs);
+            for (std::size_t j = 0; j < inputs; ++j) { weights[j] = std::sin(nn::real_t(i * inputs + j + 1)); }
+            result.emplace_back(weights, std::cos(nn::real_t(i)) / 2);
+        }
+        return result;
+    }
+
+    QuantizedNetworkTest() :
+            network({nn::HiddenLayer(neurons(4, 8), nn::act::tanh), nn::HiddenLayer(neurons(8, 6), nn::act::tanh)},
+                    nn::OutputLayer(neurons(6, 3)), nn::loss::sse) {
+        for (int i = 0; i < 40; ++i) {
+            for (int j = 0; j < 4; ++j) { inputs.push_back(nn::real_t((i * 7 + j * 3) % 11) / 10); }
+        }
+    }
+};
+
+TEST_F(QuantizedNetworkTest, PredictionsStayCloseToNetwork) {
+    nn::QuantizedNetwork quantized(network, inputs);
+    ASSERT_EQ(quantized.getSize(), network.getSize());
+    auto expected = network.predict(inputs);
+    auto actual = quantized.predict(inputs);
+    EXPECT_ALL_NEAR(actual, expected, 0.02)
+}
+
+TEST_F(QuantizedNetworkTest, SingleOutputUsesSigmoid) {
+    nn::Network binary({nn::HiddenLayer(neurons(4, 5), nn::act::relu)}, nn::OutputLayer(neurons(5, 1)), nn::loss::sse);
+    nn::QuantizedNetwork quantized(binary, inputs);
+    EXPECT_ALL_NEAR(quantized.predict(inputs), binary.predict(inputs), 0.02)
+}
+
+TEST_F(QuantizedNetworkTest, WeightsTakeOneByte) {
+    nn::QuantizedNetwork quantized(network, inputs);
+    std::size_t weights = 4 * 8 + 8 * 6 + 6 * 3, biases = 8 + 6 + 3, scales = biases + 3;
+    EXPECT_EQ(quantized.getParameterBytes(), weights + (biases + scales) * sizeof(nn::real_t));
+}
+
+TEST_F(QuantizedNetworkTest, BuffersAreReused) {
+    nn::QuantizedNetwork quantized(network, inputs);
+    nn::vd_t outputs, buffer;
+    std::vector<std::int8_t> bytes;
+    quantized.predict(inputs, outputs, buffer, bytes);
+    EXPECT_EQ(outputs, quantized.predict(inputs));
+    EXPECT_EQ(outputs.size(), 40 * 3);
+}
@@ -0,0 +1,54 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include <gtest/gtest.h>
+#include <static_network.h>
+
+#include "globals.h"
+
+TEST(StaticNetworkTest, ShapeIsKnownAtCompileTime) {
+    using Model = nn::StaticNetwork<4, 3, 4>;
+    static_assert(Model::depth == 2);
+    static_assert(Model::inputs == 4);
+    static_assert(Model::outputs == 4);
+    static_assert(std::is_same_v<Model::input_t, std::array<nn::real_t, 4>>);
+}
+
+TEST(StaticNetworkTest, PredictionsMatchDynamicNetwork) {
+    auto network = nn::make::network({4, 3, 4}, nn::act::tanh, nn::loss::sse);
+    nn::StaticNetwork<4, 3, 4> fixed(network);
+    nn::vd_t input{0.1, 0.7, -0.3, 0.5};
+    auto actual = fixed.predict({input[0], input[1], input[2], input[3]});
+    EXPECT_ALL_NEAR(actual, network.predict(input), EPSILON)
+}
+
+TEST(StaticNetworkTest, SingleOutputMatchesDynamicNetwork) {
+    auto network = nn::make::network({3, 5, 2, 1}, nn::act::relu, nn::loss::sse);
+    nn::BasicStaticNetwork<nn::act::Relu, 3, 5, 2, 1> fixed(network);
+    nn::vd_t input{0.4, -0.2, 0.9}, output(1);
+    fixed.predict(input.data(), output.data());
+    EXPECT_ALL_NEAR(output, network.predict(input), EPSILON)
+}
+
+TEST(StaticNetworkTest, ConvertsBackToDynamicNetwork) {
+    auto network = nn::make::network({2, 4, 3}, nn::act::sigmoid, nn::loss::sse);
+    nn::BasicStaticNetwork<nn::act::Sigmoid, 2, 4, 3> fixed(network);
+    auto copy = static_cast<nn::Network>(fixed);
+    ASSERT_EQ(copy.getSize(), network.getSize());
+    for (std::size_t i = 0; i < copy.getSize(); ++i) {
+        EXPECT_EQ(copy.get(i).getWeights(), network.get(i).getWeights());
+        EXPECT_EQ(copy.get(i).getBiases(), network.get(i).getBiases());
+    }
+    nn::vd_t input{0.3, -0.8};
+    EXPECT_EQ(copy.predict(input), network.predict(input));
+}
+
+TEST(StaticNetworkTest, RejectsMismatchedNetworks) {
+    using Model = nn::StaticNetwork<4, 3, 4>;
+    EXPECT_THROW(Model(nn::make::network({4, 3, 3}, nn::act::tanh, nn::loss::sse)), std::invalid_argument);
+    EXPECT_THROW(Model(nn::make::network({4, 5, 4}, nn::act::tanh, nn::loss::sse)), std::invalid_argument);
+    EXPECT_THROW(Model(nn::make::network({4, 3, 3, 4}, nn::act::tanh, nn::loss::sse)), std::invalid_argument);
+    EXPECT_THROW(Model(nn::make::network({4, 3, 4}, nn::act::relu, nn::loss::sse)), std::invalid_argument);
+    EXPECT_NO_THROW(Model(nn::make::network({4, 3, 4}, nn::act::tanh, nn::loss::sse)));
+}
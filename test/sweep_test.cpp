@@ -0,0 +1,137 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include <gtest/gtest.h>
+#include <sweep.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "globals.h"
+
+class SweepTest : public ::testing::Test {
+protected:
+    nn::vvd_t inputs, outputs;
+
+    void SetUp() override {
+        std::tie(inputs, outputs) = gridData(32, 4, 4, [](nn::real_t a, nn::real_t b) {
+            return nn::vd_t{a * b, 1 - a * b};
+        });
+    }
+
+    nn::Module module(bool testing) {
+        nn::Module m;
+        m.setTrainInput(inputs);
+        m.setTrainOutput(outputs);
+        if (testing) {
+            m.setTestInput(inputs);
+            m.setTestOutput(outputs);
+        }
+        return m;
+    }
+};
+
+TEST_F(SweepTest, GridCoversEveryCombination) {
+    nn::Sweep::Space space;
+    space.dimensions = {{2, 2, 2}, {2, 4, 2}};
+    space.activations = {nn::act::tanh, nn::act::relu};
+    space.learningRates = {0.1, 0.01, 0.001};
+    auto configurations = nn::Sweep::grid(space);
+    ASSERT_EQ(configurations.size(), 12);
+    EXPECT_EQ(configurations.front().dimensions, (nn::vi_t{2, 2, 2}));
+    EXPECT_EQ(configurations.back().dimensions, (nn::vi_t{2, 4, 2}));
+    EXPECT_EQ(configurations.back().activation.fun, nn::act::relu.fun);
+    EXPECT_NEAR(configurations.back().learningRate, 0.001, EPSILON);
+    EXPECT_EQ(configurations.back().epochs, 100);
+}
+
+TEST_F(SweepTest, RandomSearchIsSeeded) {
+    nn::Sweep::Space space;
+    space.dimensions = {{2, 2, 2}, {2, 4, 2}};
+    space.losses = {nn::loss::sse, nn::loss::crossEntropy};
+    space.learningRates = {0.001, 0.1};
+    space.epochs = {5, 10};
+    auto first = nn::Sweep::random(space, 20, 7), second = nn::Sweep::random(space, 20, 7);
+    ASSERT_EQ(first.size(), 20);
+    for (std::size_t i = 0; i < first.size(); ++i) {
+        EXPECT_EQ(first[i].dimensions, second[i].dimensions);
+        EXPECT_EQ(first[i].loss, second[i].loss);
+        EXPECT_EQ(first[i].learningRate, second[i].learningRate);
+        EXPECT_EQ(first[i].epochs, second[i].epochs);
+        EXPECT_GE(first[i].learningRate, 0.001 - EPSILON);
+        EXPECT_LE(first[i].learningRate, 0.1 + EPSILON);
+    }
+}
+
+TEST_F(SweepTest, RanksConfigurationsByTestingError) {
+    nn::Sweep::Space space;
+    space.dimensions = {{2, 2, 2}, {2, 6, 2}};
+    space.learningRates = {0.2, 0.05};
+    space.epochs = {5, 20};
+    auto configurations = nn::Sweep::grid(space);
+
+    nn::Module base = module(true);
+    nn::Sweep sweep(base);
+    sweep.setThreads(3);
+    sweep.setBatchSize(4);
+    auto results = sweep.run(configurations);
+    ASSERT_EQ(results.size(), configurations.size());
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        EXPECT_FALSE(std::isnan(results[i].testError));
+        EXPECT_FALSE(std::isnan(results[i].trainError));
+        EXPECT_GE(results[i].seconds, 0);
+        if (i > 0) { EXPECT_LE(results[i - 1].testError, results[i].testError); }
+    }
+    // Every configuration is trained once
+    for (const auto &configuration: configurations) {
+        EXPECT_EQ(std::count_if(results.begin(), results.end(), [&](const nn::Sweep::Result &result) {
+            return result.configuration.dimensions == configuration.dimensions
+                   && result.configuration.learningRate == configuration.learningRate
+                   && result.configuration.epochs == configuration.epochs;
+        }), 1);
+    }
+    EXPECT_EQ(base.getTrainInput(), inputs);
+}
+
+TEST_F(SweepTest, SeededRunsAreReproducible) {
+    nn::Sweep::Space space;
+    space.dimensions = {{2, 4, 2}, {2, 8, 2}};
+    space.learningRates = {0.1};
+    space.epochs = {10};
+    auto configurations = nn::Sweep::random(space, 6, 2);
+
+    auto run = [&](std::size_t threads, std::uint32_t seed) {
+        nn::Sweep sweep(module(true));
+        sweep.setThreads(threads);
+        sweep.setSeed(seed);
+        std::vector<nn::real_t> errors;
+        for (const auto &result: sweep.run(configurations)) { errors.push_back(result.trainError); }
+        return errors;
+    };
+    auto errors = run(2, 7);
+    EXPECT_EQ(run(2, 7), errors);
+    EXPECT_EQ(run(3, 7), errors);
+    EXPECT_NE(run(2, 8), errors);
+}
+
+TEST_F(SweepTest, RanksByTrainingErrorWithoutTestingData) {
+    nn::Sweep sweep(module(false));
+    auto results = sweep.run({{{2, 3, 2}, nn::act::tanh, nn::loss::sse, 0.1, 3},
+                              {{2, 3, 2}, nn::act::tanh, nn::loss::sse, 0.01, 3}});
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_TRUE(std::isnan(results[0].testError));
+    EXPECT_LE(results[0].trainError, results[1].trainError);
+}
+
+TEST_F(SweepTest, ModuleCopiesShareDataUntilChanged) {
+    nn::Module original = module(true);
+    nn::Module copy = original;
+    nn::vvd_t other = {{4, 5}, {6, 7}};
+    copy.setTrainInput(other);
+    copy.setTestOutput(other);
+    EXPECT_EQ(copy.getTrainInput(), other);
+    EXPECT_EQ(copy.getTestOutput(), other);
+    EXPECT_EQ(original.getTrainInput(), inputs);
+    EXPECT_EQ(original.getTestOutput(), outputs);
+}
@@ -0,0 +1,45 @@
+//
+// Created by Izzat on 10/17/2026.
+//
+
+#include <gtest/gtest.h>
+#include <thread_pool.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+
+TEST(ThreadPoolTest, RunsTaskOncePerWorker) {
+    nn::ThreadPool pool(4);
+    EXPECT_EQ(pool.size(), 4);
+    for (int round = 0; round < 3; ++round) {
+        std::vector<int> calls(pool.size());
+        pool.run([&calls](std::size_t i) { ++calls[i]; });
+        EXPECT_EQ(calls, std::vector<int>(pool.size(), 1));
+    }
+}
+
+TEST(ThreadPoolTest, ZeroSizeUsesHardwareConcurrency) {
+    nn::ThreadPool pool(0);
+    EXPECT_EQ(pool.size(), nn::ThreadPool::concurrency());
+    std::atomic<std::size_t> sum{0};
+    pool.run([&sum](std::size_t i) { sum += i + 1; });
+    EXPECT_EQ(sum.load(), pool.size() * (pool.size() + 1) / 2);
+}
+
+TEST(ThreadPoolTest, RethrowsAfterEveryWorkerFinishes) {
+    nn::ThreadPool pool(4);
+    for (std::size_t thrower: {std::size_t(0), std::size_t(2)}) {
+        std::atomic<std::size_t> finished{0};
+        EXPECT_THROW(pool.run([&](std::size_t i) {
+            if (i == thrower) { throw std::runtime_error("task failed"); }
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            ++finished;
+        }), std::runtime_error);
+        EXPECT_EQ(finished.load(), pool.size() - 1);
+    }
+    // The pool stays usable
+    std::atomic<std::size_t> calls{0};
+    pool.run([&calls](std::size_t) { ++calls; });
+    EXPECT_EQ(calls.load(), pool.size());
+}
@@ -40,6 +40,20 @@ function toVecVecVecNum(arrArrArr) {
     return vecVecVec;
 }
 
+function heapArray(pointer, length) {
+    const HeapArray = Module.Network.getPrecision() === 'float32' ? Float32Array : Float64Array;
+    return new HeapArray(Module.HEAPU8.buffer, pointer, length);
+}
+
+// Copies a view returned by the network, views are invalidated when the WASM memory grows.
+function viewToArrArr(matrix) {
+    const arrArr = [];
+    for (let i = 0; i < matrix.rows; i++) {
+        arrArr.push(Array.from(matrix.data.subarray(i * matrix.columns, (i + 1) * matrix.columns)));
+    }
+    return arrArr;
+}
+
 function csvToArrArr(csvString) {
     const arrArr = [];
     const lines = csvString.split('\n');
@@ -0,0 +1,139 @@
+// Training worker, hosts its own copy of the network so long trainings don't freeze the page.
+// Loaded by TrainingWorker (training.js), needs the module built with NN_WASM_WORKER.
+//
+// Messages from the page:
+// - {type: 'start', setup, epochs, chunk, delay, withTest}: rebuilds the network from the setup and trains
+//   `epochs` epochs, `chunk` epochs at a time with `delay` ms between chunks
+// - {type: 'pause'}: stops after the current chunk, keeping the remaining epochs
+// - {type: 'resume'}: continues a paused training
+// - {type: 'cancel'}: drops the remaining epochs, also ends a paused training
+// Messages to the page:
+// - {type: 'ready'}: the module is loaded
+// - {type: 'progress', trainingErrors, testingErrors, profile}: errors of the epochs trained since the last
+//   progress, and the training counters of the run (see NetworkController::getProfile)
+// - {type: 'paused' | 'stopped', parameters}: the weights and biases of every layer when training halts
+importScripts('../wasm/worker.js');
+
+let network = null;
+let remaining = 0;
+let running = false;
+let chunk = 1;
+let delay = 0;
+let withTest = false;
+let reported = 0;
+
+Module.onRuntimeInitialized = () => {
+    network = new Module.Network();
+    postMessage({type: 'ready'});
+};
+
+function heapArray(pointer, length) {
+    const HeapArray = Module.Network.getPrecision() === 'float32' ? Float32Array : Float64Array;
+    return new HeapArray(Module.HEAPU8.buffer, pointer, length);
+}
+
+function toVecUInt(arr) {
+    const vec = new Module.VecUInt();
+    for (let i of arr) vec.push_back(Number(i));
+    return vec;
+}
+
+function applySetup(setup) {
+    network.setDimensions(toVecUInt(setup.dimensions));
+    network.setActivationFunction(setup.activationFunction);
+    network.setLossFunction(setup.lossFunction);
+    network.setLearningRate(setup.learningRate);
+    network.setBatchSize(setup.batchSize);
+    network.setOptimizer(setup.optimizer);
+    network.setSampling(setup.sampling);
+    Module.Network.setActivationAccuracy(setup.activationAccuracy);
+
+    network.setTrainInputCsv(setup.trainInputCsv, setup.encoding);
+    network.setTrainOutputCsv(setup.trainOutputCsv, setup.encoding);
+    if (setup.testInputCsv && setup.testOutputCsv) {
+        network.setTestInputCsv(setup.testInputCsv);
+        network.setTestOutputCsv(setup.testOutputCsv);
+    }
+
+    setup.parameters.forEach((layer, i) => {
+        const values = heapArray(network.allocateBuffer(layer.weights.length + layer.biases.length),
+            layer.weights.length + layer.biases.length);
+        values.set(layer.weights);
+        values.set(layer.biases, layer.weights.length);
+        if (!network.setLayerBuffer(i)) throw new Error(`Parameters of layer ${i} don't match the network`);
+    });
+    network.resetProgress();
+    network.resetProfile();
+    reported = 0;
+}
+
+function getParameters() {
+    const layers = network.getDimensions().size() - 1;
+    const parameters = [];
+    for (let i = 0; i < layers; i++) {
+        parameters.push({
+            weights: network.getWeightsView(i).data.slice(),
+            biases: network.getBiasesView(i).data.slice()
+        });
+    }
+    return parameters;
+}
+
+function postProgress() {
+    const count = network.getProgressCount();
+    const ring = network.getProgressView();
+    const trainingErrors = [], testingErrors = [];
+    for (let i = Math.max(reported, count - ring.rows); i < count; i++) {
+        const row = (i % ring.rows) * ring.columns;
+        trainingErrors.push(ring.data[row]);
+        if (withTest) testingErrors.push(ring.data[row + 1]);
+    }
+    reported = count;
+    postMessage({type: 'progress', trainingErrors, testingErrors, profile: network.getProfile()});
+}
+
+function halt(type) {
+    running = false;
+    if (type === 'stopped') remaining = 0;
+    postMessage({type, parameters: getParameters()});
+}
+
+// Trains one chunk at a time, yielding between chunks so pause and cancel messages are handled.
+function step() {
+    if (!running) return;
+    remaining -= network.trainChunk(Math.min(chunk, remaining), withTest);
+    postProgress();
+    if (!running) return;
+    if (remaining > 0) setTimeout(step, delay);
+    else halt('stopped');
+}
+
+onmessage = (event) => {
+    const message = event.data;
+    switch (message.type) {
+        case 'start':
+            applySetup(message.setup);
+            remaining = message.epochs;
+            chunk = Math.max(1, message.chunk);
+            delay = message.delay;
+            withTest = message.withTest;
+            running = true;
+            step();
+            break;
+        case 'pause':
+            if (running) halt('paused');
+            break;
+        case 'resume':
+            if (!running && remaining > 0) {
+                running = true;
+                step();
+            }
+            break;
+        case 'cancel':
+            if (network) {
+                network.cancelTraining();
+                halt('stopped');
+            }
+            break;
+    }
+};
@@ -0,0 +1,111 @@
+// Runs training in a Web Worker (trainer.js) and streams the epoch errors back to the page.
+// `available` stays false if the worker module wasn't built, the page then trains on the main thread.
+//
+// The page's network stays the source of truth between runs: every run starts from its setup and
+// parameters, and the trained parameters are copied back whenever the worker pauses or stops.
+class TrainingWorker {
+    // handlers: getSetup() for the setup of a new run, onProgress(trainingErrors, testingErrors, profile)
+    // and onParameters(parameters) when the worker halts.
+    constructor(url, handlers) {
+        this.available = false;
+        this.running = false;
+        this.paused = false;
+        this.discard = false;
+        this.pending = null;
+        this.handlers = handlers;
+        try {
+            this.worker = new Worker(url);
+        } catch (e) {
+            return;
+        }
+        this.worker.onerror = () => {
+            this.available = false;
+            this.running = false;
+        };
+        this.worker.onmessage = (event) => this.handle(event.data);
+    }
+
+    handle(message) {
+        switch (message.type) {
+            case 'ready':
+                this.available = true;
+                break;
+            case 'progress':
+                if (!this.discard) this.handlers.onProgress(message.trainingErrors, message.testingErrors, message.profile);
+                break;
+            case 'paused':
+                this.handlers.onParameters(message.parameters);
+                break;
+            case 'stopped':
+                if (!this.discard) this.handlers.onParameters(message.parameters);
+                this.running = false;
+                this.paused = false;
+                this.discard = false;
+                if (this.pending) {
+                    const run = this.pending;
+                    this.pending = null;
+                    this.start(run.epochs, run.chunk, run.delay, run.withTest);
+                }
+                break;
+        }
+    }
+
+    // Trains `epochs` epochs, posting progress every `chunk` epochs and waiting `delay` ms between chunks.
+    // A running training is stopped first, the new one starts once its parameters are copied back.
+    start(epochs, chunk, delay, withTest) {
+        if (this.running) {
+            this.pending = {epochs, chunk, delay, withTest};
+            this.cancel();
+            return;
+        }
+        this.running = true;
+        this.paused = false;
+        this.worker.postMessage({type: 'start', setup: this.handlers.getSetup(), epochs, chunk, delay, withTest});
+    }
+
+    pause() {
+        if (this.running && !this.paused) {
+            this.paused = true;
+            this.worker.postMessage({type: 'pause'});
+        }
+    }
+
+    resume() {
+        if (this.running && this.paused) {
+            this.paused = false;
+            this.worker.postMessage({type: 'resume'});
+        }
+    }
+
+    // Stops the training, dropping its results when `discard` is set, e.g. when the network was rebuilt.
+    cancel(discard = false) {
+        if (!this.running) return;
+        this.discard = this.discard || discard;
+        if (discard) this.pending = null;
+        this.worker.postMessage({type: 'cancel'});
+    }
+}
+
+// Copies trained parameters from the worker into the page's network.
+function setParameters(network, parameters) {
+    parameters.forEach((layer, i) => {
+        const length = layer.weights.length + layer.biases.length;
+        const values = heapArray(network.allocateBuffer(length), length);
+        values.set(layer.weights);
+        values.set(layer.biases, layer.weights.length);
+        if (!network.setLayerBuffer(i)) throw new Error(`Parameters of layer ${i} don't match the network`);
+    });
+}
+
+// Views are copied since the page's WASM memory may grow while the message is in flight.
+function getParameters(network) {
+    const layers = toArr(network.getDimensions()).length - 1;
+    const parameters = [];
+    for (let i = 0; i < layers; i++) {
+        parameters.push({
+            weights: network.getWeightsView(i).data.slice(),
+            biases: network.getBiasesView(i).data.slice()
+        });
+    }
+    return parameters;
+}